@@ -0,0 +1,334 @@
+/*
+ * This module selects the solver backend which solver.c uses to solve the board.
+ * Every backend implements the contract of solveBoard (see gurobi.h).
+ * The native backend (native_solver.c) and the SAT backend (sat_solver.c) are always available,
+ * the Gurobi backend (gurobi.c) only when the program is built with USE_GUROBI.
+ * guessCellValues and guessSolution solve the LP relaxation of the board, which every backend has
+ * (the native and SAT ones in native_lp.c). Only Gurobi can find a pool of solutions in one solve.
+ * When both are built, the race backend runs them concurrently on every board and takes whichever
+ * finishes first, and it is the default one.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <string.h>
+#include "backend.h"
+#include "native_solver.h"
+#include "native_lp.h"
+#include "sat_solver.h"
+#ifdef USE_GUROBI
+#include <pthread.h>
+#include "gurobi.h"
+#endif
+
+struct solverBackend {
+    char *name;
+    int available;
+    int (*solveBoard)(struct boardView *view, int *retBoard);
+    int (*guessCellValues)(struct boardView *view, int row, int col,
+                           int **pCellValues, double **pScores, int *pLength);
+    int (*guessSolution)(struct boardView *view, float threshold, int samples, int *retBoard);
+    int (*solvePool)(struct boardView *view, int *retBoards, int maxSolutions, int *pCount); /* or NULL */
+};
+
+#define NUM_BACKENDS 4
+
+/* the wins of every kind of board raced so far */
+static struct raceRecord *raceRecords = NULL;
+static int numRaceRecords = 0;
+
+/*
+ * This function counts a race over the board seen through view, won by winner.
+ * The statistics only help to tune the choice of a backend, so a race that can not be
+ * recorded for lack of memory is left out.
+ */
+void recordRaceWin(struct boardView *view, enum raceSide winner){
+    int i, row, col, filled = 0, quarter, N = viewLen(view);
+    struct raceRecord *records;
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            filled += (viewCell(view, row, col) != 0);
+        }
+    }
+    quarter = (filled * 4) / (N * N + 1);
+    for (i = 0; i < numRaceRecords; i++){
+        if ((raceRecords[i].m == view->m) && (raceRecords[i].n == view->n)
+            && (raceRecords[i].filledQuarter == quarter)){
+            break;
+        }
+    }
+    if (i == numRaceRecords){ /* the first race over this kind of board */
+        records = (struct raceRecord *)realloc(raceRecords, (numRaceRecords + 1) * sizeof(struct raceRecord));
+        if (records == NULL){
+            return;
+        }
+        raceRecords = records;
+        raceRecords[i].m = view->m;
+        raceRecords[i].n = view->n;
+        raceRecords[i].filledQuarter = quarter;
+        raceRecords[i].wins[gurobiSide] = raceRecords[i].wins[nativeSide] = 0;
+        numRaceRecords++;
+    }
+    raceRecords[i].wins[winner]++;
+}
+
+/*
+ * This method returns the race statistics, and their amount through *pCount.
+ */
+struct raceRecord *raceStatistics(int *pCount){
+    *pCount = numRaceRecords;
+    return raceRecords;
+}
+
+#ifdef USE_GUROBI
+
+/*
+ * A race between Gurobi and the native search over one board.
+ * Each side solves into its own board, and the first to find the board valid or invalid wins
+ * and stops the other. A side that fails does not win, so the other one may still answer.
+ */
+struct boardRace {
+    struct boardView *view;
+    int *boards[NUM_RACE_SIDES]; /* NULL if no solution is needed */
+    int res[NUM_RACE_SIDES];
+    volatile int stop[NUM_RACE_SIDES];
+    int winner; /* -1 while no side has won */
+    pthread_mutex_t lock;
+};
+
+/*
+ * This function ends side's part in race with result res, and stops the other side if side won.
+ * Both sides spend the same budget, so once it ran out for one side the other is stopped too.
+ */
+void finishRace(struct boardRace *race, enum raceSide side, int res){
+    pthread_mutex_lock(&(race->lock));
+    race->res[side] = res;
+    if ((race->winner == -1) && ((res == 0) || (res == 1))){
+        race->winner = side;
+        race->stop[(side == gurobiSide) ? nativeSide : gurobiSide] = 1;
+    }
+    else if (res == -4){
+        race->stop[(side == gurobiSide) ? nativeSide : gurobiSide] = 1;
+    }
+    pthread_mutex_unlock(&(race->lock));
+}
+
+/*
+ * This function is the thread of the Gurobi side of a race.
+ */
+void *runGurobiSide(void *arg){
+    struct boardRace *race = (struct boardRace *)arg;
+    finishRace(race, gurobiSide, solveBoardUntil(race->view, race->boards[gurobiSide], &(race->stop[gurobiSide])));
+    return NULL;
+}
+
+/*
+ * This method solves the board seen through view by racing Gurobi, on a thread of its own,
+ * against the native search, on the calling thread, and records which one won.
+ * If the race can not start, the board is solved by Gurobi alone.
+ * Return values are those of solveBoard.
+ */
+int raceSolveBoard(struct boardView *view, int *retBoard){
+    struct boardRace race;
+    pthread_t gurobiThread;
+    int i, side, res, N = viewLen(view);
+
+    race.view = view;
+    race.winner = -1;
+    for (side = 0; side < NUM_RACE_SIDES; side++){
+        race.boards[side] = NULL;
+        race.res[side] = -1;
+        race.stop[side] = 0;
+    }
+    if (retBoard != NULL){
+        race.boards[gurobiSide] = (int *)malloc(N * N * sizeof(int));
+        race.boards[nativeSide] = (int *)malloc(N * N * sizeof(int));
+        if ((race.boards[gurobiSide] == NULL) || (race.boards[nativeSide] == NULL)){
+            free(race.boards[gurobiSide]);
+            free(race.boards[nativeSide]);
+            return -2;
+        }
+    }
+    if (pthread_mutex_init(&(race.lock), NULL) != 0){
+        free(race.boards[gurobiSide]);
+        free(race.boards[nativeSide]);
+        return solveBoard(view, retBoard);
+    }
+    if (pthread_create(&gurobiThread, NULL, runGurobiSide, &race) != 0){
+        pthread_mutex_destroy(&(race.lock));
+        free(race.boards[gurobiSide]);
+        free(race.boards[nativeSide]);
+        return solveBoard(view, retBoard);
+    }
+    finishRace(&race, nativeSide, solveBoardNativeUntil(view, race.boards[nativeSide], &(race.stop[nativeSide])));
+    pthread_join(gurobiThread, NULL);
+    pthread_mutex_destroy(&(race.lock));
+
+    if (race.winner == -1){ /* both sides failed, Gurobi tells better why unless the budget ran out */
+        res = ((race.res[gurobiSide] == -3) || (race.res[nativeSide] == -4)) ?
+              race.res[nativeSide] : race.res[gurobiSide];
+    }
+    else{
+        res = race.res[race.winner];
+        recordRaceWin(view, (enum raceSide)race.winner);
+        if ((res == 1) && (retBoard != NULL)){
+            for (i = 0; i < N * N; i++){
+                retBoard[i] = race.boards[race.winner][i];
+            }
+        }
+    }
+    free(race.boards[gurobiSide]);
+    free(race.boards[nativeSide]);
+    return res;
+}
+
+static struct solverBackend backends[NUM_BACKENDS] = {
+        {"race", 1, raceSolveBoard, guessCellValues, guessSolution, solveBoardPool},
+        {"gurobi", 1, solveBoard, guessCellValues, guessSolution, solveBoardPool},
+        {"native", 1, solveBoardNative, guessCellValuesNative, guessSolutionNative, NULL},
+        {"sat", 1, solveBoardSat, guessCellValuesNative, guessSolutionNative, NULL}
+};
+#else
+static struct solverBackend backends[NUM_BACKENDS] = {
+        {"race", 0, NULL, NULL, NULL, NULL},
+        {"gurobi", 0, NULL, NULL, NULL, NULL},
+        {"native", 1, solveBoardNative, guessCellValuesNative, guessSolutionNative, NULL},
+        {"sat", 1, solveBoardSat, guessCellValuesNative, guessSolutionNative, NULL}
+};
+#endif
+
+/* the first available backend is the default one */
+static struct solverBackend *current = NULL;
+
+/*
+ * This method returns the selected backend, selecting the default one on first use.
+ */
+struct solverBackend *currentBackend(){
+    int i;
+    if (current == NULL){
+        for (i = 0; (i < NUM_BACKENDS) && (current == NULL); i++){
+            if (backends[i].available){
+                current = &backends[i];
+            }
+        }
+    }
+    return current;
+}
+
+/*
+ * This function selects the solver backend by its name.
+ * Return values:
+ * -2: the backend is not included in this build.
+ * -1: there is no backend with this name.
+ *  0: the backend was selected.
+ */
+int selectBackend(char *name){
+    int i;
+    for (i = 0; i < NUM_BACKENDS; i++){
+        if (!strcmp(name, backends[i].name)){
+            if (!backends[i].available){
+                return -2;
+            }
+            current = &backends[i];
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/*
+ * This method returns the name of the selected backend.
+ */
+char *backendName(){
+    return currentBackend()->name;
+}
+
+/*
+ * This function prepares the backends which have a costly startup in the background,
+ * so the first command that solves the board does not wait for it.
+ */
+void warmUpBackends(){
+#ifdef USE_GUROBI
+    warmGurobiEnvironment();
+#endif
+}
+
+/*
+ * This function frees every resource the backends keep for the whole session.
+ */
+void releaseBackends(){
+    freeNativeLP();
+    freeSatFormula();
+    free(raceRecords);
+    raceRecords = NULL;
+    numRaceRecords = 0;
+#ifdef USE_GUROBI
+    freeGurobiEnvironment();
+#endif
+}
+
+/*
+ * This method solves the board seen through view using the selected backend.
+ * The solution is returned through retBoard, unless retBoard == NULL.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ * -1: the backend had an error.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoard is filled with a solution.
+ */
+int backendSolveBoard(struct boardView *view, int *retBoard){
+    return currentBackend()->solveBoard(view, retBoard);
+}
+
+/*
+ * This method returns 1 if the selected backend can find a pool of solutions in one solve, and 0 otherwise.
+ */
+int backendHasSolutionPool(){
+    return currentBackend()->solvePool != NULL;
+}
+
+/*
+ * This method solves the board seen through view for a pool of up to maxSolutions different solutions,
+ * like solveBoardPool in gurobi.h, using the selected backend. It assumes backendHasSolutionPool().
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ * -1: the backend had an error.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoards is filled with *pCount >= 1 solutions.
+ */
+int backendSolvePool(struct boardView *view, int *retBoards, int maxSolutions, int *pCount){
+    return currentBackend()->solvePool(view, retBoards, maxSolutions, pCount);
+}
+
+/*
+ * This function guesses the values of cell <row, col> using the LP of the selected backend,
+ * like guessCellValues in gurobi.h.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ * -1: the backend had an error.
+ *  0: the board is invalid.
+ *  1: cell <row, col> values were successfully guessed.
+ * User needs to free *pCellValues and *pScores iff return value == 1.
+ */
+int backendGuessCellValues(struct boardView *view, int row, int col,
+                           int **pCellValues, double **pScores, int *pLength){
+    return currentBackend()->guessCellValues(view, row, col, pCellValues, pScores, pLength);
+}
+
+/*
+ * This function guesses a solution to the board using the LP of the selected backend,
+ * keeping the best of samples roundings, like guessSolution in gurobi.h.
+ * Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ * -1: the backend had an error.
+ *  0: the board is invalid.
+ *  1: the board was successfully guessed.
+ */
+int backendGuessSolution(struct boardView *view, float threshold, int samples, int *retBoard){
+    return currentBackend()->guessSolution(view, threshold, samples, retBoard);
+}
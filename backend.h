@@ -0,0 +1,120 @@
+/*
+ * This module selects the solver backend which solver.c uses to solve the board.
+ * Every backend implements the contract of solveBoard (see gurobi.h).
+ * The native backend (native_solver.c) and the SAT backend (sat_solver.c) are always available,
+ * the Gurobi backend (gurobi.c) only when the program is built with USE_GUROBI.
+ * guessCellValues and guessSolution solve the LP relaxation of the board, which every backend has
+ * (the native and SAT ones in native_lp.c). Only Gurobi can find a pool of solutions in one solve.
+ * When both are built, the race backend runs them concurrently on every board and takes whichever
+ * finishes first, and it is the default one.
+ */
+
+#ifndef SOFTWAREPROJECTFINALPROJECT_BACKEND_H
+#define SOFTWAREPROJECTFINALPROJECT_BACKEND_H
+
+#include "util/board_view.h"
+
+enum raceSide {
+    gurobiSide = 0,
+    nativeSide = 1
+};
+
+#define NUM_RACE_SIDES 2
+
+/*
+ * The races the race backend ran over one kind of board: m*n boards of which
+ * the given quarter of the cells (0 to 3) is filled.
+ */
+struct raceRecord {
+    int m;
+    int n;
+    int filledQuarter;
+    long wins[NUM_RACE_SIDES];
+};
+
+/*
+ * This method returns the race statistics, and their amount through *pCount.
+ */
+struct raceRecord *raceStatistics(int *pCount);
+
+/*
+ * This function selects the solver backend by its name.
+ * Return values:
+ * -2: the backend is not included in this build.
+ * -1: there is no backend with this name.
+ *  0: the backend was selected.
+ */
+int selectBackend(char *name);
+
+/*
+ * This method returns the name of the selected backend.
+ */
+char *backendName();
+
+/*
+ * This function prepares the backends which have a costly startup in the background,
+ * so the first command that solves the board does not wait for it.
+ */
+void warmUpBackends();
+
+/*
+ * This function frees every resource the backends keep for the whole session.
+ */
+void releaseBackends();
+
+/*
+ * This method solves the board seen through view using the selected backend.
+ * The solution is returned through retBoard, unless retBoard == NULL.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ * -1: the backend had an error.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoard is filled with a solution.
+ */
+int backendSolveBoard(struct boardView *view, int *retBoard);
+
+/*
+ * This method returns 1 if the selected backend can find a pool of solutions in one solve, and 0 otherwise.
+ */
+int backendHasSolutionPool();
+
+/*
+ * This method solves the board seen through view for a pool of up to maxSolutions different solutions,
+ * like solveBoardPool in gurobi.h, using the selected backend. It assumes backendHasSolutionPool().
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ * -1: the backend had an error.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoards is filled with *pCount >= 1 solutions.
+ */
+int backendSolvePool(struct boardView *view, int *retBoards, int maxSolutions, int *pCount);
+
+/*
+ * This function guesses the values of cell <row, col> using the LP of the selected backend,
+ * like guessCellValues in gurobi.h.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ * -1: the backend had an error.
+ *  0: the board is invalid.
+ *  1: cell <row, col> values were successfully guessed.
+ * User needs to free *pCellValues and *pScores iff return value == 1.
+ */
+int backendGuessCellValues(struct boardView *view, int row, int col,
+                           int **pCellValues, double **pScores, int *pLength);
+
+/*
+ * This function guesses a solution to the board using the LP of the selected backend,
+ * keeping the best of samples roundings, like guessSolution in gurobi.h.
+ * Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ * -1: the backend had an error.
+ *  0: the board is invalid.
+ *  1: the board was successfully guessed.
+ */
+int backendGuessSolution(struct boardView *view, float threshold, int samples, int *retBoard);
+
+#endif
@@ -0,0 +1,287 @@
+/*
+ * This module generates batches of boards into files, on a pool of worker threads,
+ * for building collections of boards offline.
+ * Every board is filled with a random solution by the native search, and left with a number of its cells.
+ * Board number i of a batch is drawn from stream i of the seed of the batch, so the boards depend
+ * only on the seed, and not on the number of threads or on which thread made which board.
+ * The workers take the next board number from the batch, and hand the finished board back to it;
+ * whichever worker hands back the board the output waits for writes it, and the boards after it
+ * which are already finished.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "batch.h"
+#include "native_solver.h"
+#include "util/board_manager.h"
+#include "util/board_view.h"
+#include "util/random.h"
+#include "util/budget.h"
+
+#define BOARD_FILE_NAME_LENGTH 32 /* enough for "/", a board number and ".txt" */
+
+/*
+ * A batch being generated, which its workers share under lock.
+ */
+struct boardBatch {
+    int m;
+    int n;
+    int count;
+    int filled;
+    unsigned long seed;
+    char *path;
+    FILE *file; /* the file all boards are written to, or NULL if path is a directory */
+    int next; /* the next board number for a worker to take */
+    int nextToWrite;
+    int **finished; /* the finished boards waiting for the boards before them, by number, or NULL */
+    int failure; /* 0, or the return value of the first failure, after which no board is taken */
+    pthread_mutex_t lock;
+};
+
+/*
+ * This function writes board, of m*n blocks, to file in the format of the save command, with its cells fixed.
+ * It returns -1 if writing failed, and 0 otherwise.
+ */
+int writeBatchBoard(FILE *file, int m, int n, int *board){
+    int row, col, N = m * n;
+    fprintf(file, "%d %d \n", m, n);
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            if (board[matIndex(m, n, row, col)] != 0){
+                fprintf(file, "%d.", board[matIndex(m, n, row, col)]);
+            }
+            else{
+                fprintf(file, "0");
+            }
+            if (col != N - 1){
+                fprintf(file, " ");
+            }
+            else if (row != N - 1){
+                fprintf(file, "\n");
+            }
+        }
+    }
+    return ferror(file) ? -1 : 0;
+}
+
+/*
+ * This function writes board number i of batch, to its own file or after the previous boards.
+ * It returns -2 if a file could not be opened or written, -1 if memory allocation failed, and 0 otherwise.
+ */
+int writeBatchOutput(struct boardBatch *batch, int i, int *board){
+    char *name;
+    FILE *file;
+    int res;
+    if (batch->file != NULL){
+        if ((i > 0) && (fprintf(batch->file, "\n\n") < 0)){
+            return -2;
+        }
+        return (writeBatchBoard(batch->file, batch->m, batch->n, board) == -1) ? -2 : 0;
+    }
+    name = (char *)malloc(strlen(batch->path) + BOARD_FILE_NAME_LENGTH);
+    if (name == NULL){
+        return -1;
+    }
+    sprintf(name, "%s/%d.txt", batch->path, i);
+    file = fopen(name, "w");
+    free(name);
+    if (file == NULL){
+        return -2;
+    }
+    res = writeBatchBoard(file, batch->m, batch->n, board);
+    return ((fclose(file) != 0) || (res == -1)) ? -2 : 0;
+}
+
+/*
+ * This function records that batch failed with failure, unless it already failed,
+ * so no more boards are taken or written.
+ */
+void failBatch(struct boardBatch *batch, int failure){
+    pthread_mutex_lock(&(batch->lock));
+    if (batch->failure == 0){
+        batch->failure = failure;
+    }
+    pthread_mutex_unlock(&(batch->lock));
+}
+
+/*
+ * This function hands the finished board number i back to batch,
+ * and writes every finished board the output is waiting for.
+ */
+void finishBatchBoard(struct boardBatch *batch, int i, int *board){
+    int res;
+    pthread_mutex_lock(&(batch->lock));
+    batch->finished[i] = board;
+    while ((batch->failure == 0) && (batch->nextToWrite < batch->count)
+           && (batch->finished[batch->nextToWrite] != NULL)){
+        res = writeBatchOutput(batch, batch->nextToWrite, batch->finished[batch->nextToWrite]);
+        if (res != 0){
+            batch->failure = res;
+            break;
+        }
+        free(batch->finished[batch->nextToWrite]);
+        batch->finished[batch->nextToWrite++] = NULL;
+    }
+    pthread_mutex_unlock(&(batch->lock));
+}
+
+/*
+ * This method takes the next board number of batch for a worker.
+ * It returns -1 once there are no boards left, or a board failed.
+ */
+int takeBatchBoard(struct boardBatch *batch){
+    int i = -1;
+    pthread_mutex_lock(&(batch->lock));
+    if ((batch->failure == 0) && (batch->next < batch->count)){
+        i = batch->next++;
+    }
+    pthread_mutex_unlock(&(batch->lock));
+    return i;
+}
+
+/*
+ * This function empties cellsToEmpty random cells of board, of area cells, drawing from random.
+ * order is scratch for area cells.
+ */
+void emptyBatchCells(int *board, int area, int cellsToEmpty, int *order, struct randomStream *random){
+    int i, j, tmp;
+    for (i = 0; i < area; i++){
+        order[i] = i;
+    }
+    for (i = 0; i < cellsToEmpty; i++){ /* the first i cells of order are a uniform choice */
+        j = i + randomBelow(random, area - i);
+        tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+        board[order[i]] = 0;
+    }
+}
+
+/*
+ * This function is a worker of a batch: it generates the boards it takes, until none are left.
+ */
+void *runBatchWorker(void *arg){
+    struct boardBatch *batch = (struct boardBatch *)arg;
+    struct sudokuManager empty;
+    struct boardView view;
+    struct randomStream random;
+    int i, res, *board, *order, area = batch->m * batch->n * batch->m * batch->n;
+
+    empty.m = batch->m;
+    empty.n = batch->n;
+    empty.emptyCells = area;
+    empty.board = (int *)calloc(area, sizeof(int));
+    order = (int *)malloc(area * sizeof(int));
+    if ((empty.board == NULL) || (order == NULL) || (initBoardView(&view, &empty) == -1)){
+        free(empty.board);
+        free(order);
+        failBatch(batch, -1);
+        return NULL;
+    }
+    for (i = takeBatchBoard(batch); i != -1; i = takeBatchBoard(batch)){
+        if (budgetExhausted()){ /* no time or work left for another board */
+            failBatch(batch, -3);
+            break;
+        }
+        board = (int *)malloc(area * sizeof(int));
+        if (board == NULL){
+            failBatch(batch, -1);
+            break;
+        }
+        seedRandom(&random, batch->seed, (unsigned long)i);
+        res = fillBoardNativeRandom(&view, &random, board);
+        if (res != 1){ /* an empty board always has a solution */
+            free(board);
+            failBatch(batch, (res == -4) ? -3 : -1);
+            break;
+        }
+        emptyBatchCells(board, area, area - batch->filled, order, &random);
+        finishBatchBoard(batch, i, board);
+    }
+    freeBoardView(&view);
+    free(empty.board);
+    free(order);
+    return NULL;
+}
+
+/*
+ * This function generates count boards of m*n blocks, each with filled cells left, drawn from seed,
+ * on threads worker threads (one per online processor if threads == 0).
+ * If path is a directory, board number i is written to the file i.txt in it, and otherwise all boards
+ * are written to the file at path, one after the other with an empty line between them.
+ * Either way they are written in the format of the save command with their cells fixed,
+ * in the order of their numbers, each as soon as all the boards before it were written.
+ * The number of boards written is returned through *pWritten.
+ * Return values:
+ * -3: the budget of the command ran out.
+ * -2: a file could not be opened or written.
+ * -1: memory allocation failed.
+ *  1: all boards were written.
+ */
+int generateBatch(int m, int n, int count, int filled, unsigned long seed, char *path, int threads, int *pWritten){
+    struct boardBatch batch;
+    struct stat pathStat;
+    pthread_t *workers;
+    int i, started = 0;
+
+    *pWritten = 0;
+    batch.m = m;
+    batch.n = n;
+    batch.count = count;
+    batch.filled = filled;
+    batch.seed = seed;
+    batch.path = path;
+    batch.next = batch.nextToWrite = 0;
+    batch.failure = 0;
+    batch.file = NULL;
+    if ((stat(path, &pathStat) != 0) || !S_ISDIR(pathStat.st_mode)){
+        batch.file = fopen(path, "w");
+        if (batch.file == NULL){
+            return -2;
+        }
+    }
+    if (threads == 0){
+        threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (threads < 1) ? 1 : threads;
+    }
+    threads = (threads > count) ? count : threads;
+    batch.finished = (int **)calloc(count, sizeof(int *));
+    workers = (pthread_t *)malloc(threads * sizeof(pthread_t));
+    if ((batch.finished == NULL) || (workers == NULL) || (pthread_mutex_init(&(batch.lock), NULL) != 0)){
+        free(batch.finished);
+        free(workers);
+        if (batch.file != NULL){
+            fclose(batch.file);
+        }
+        return -1;
+    }
+
+    /* the calling thread is one of the workers, so a batch runs even if no thread can start */
+    for (i = 0; i < threads - 1; i++){
+        if (pthread_create(&workers[started], NULL, runBatchWorker, &batch) == 0){
+            started++;
+        }
+    }
+    runBatchWorker(&batch);
+    for (i = 0; i < started; i++){
+        pthread_join(workers[i], NULL);
+    }
+
+    pthread_mutex_destroy(&(batch.lock));
+    for (i = 0; i < count; i++){ /* boards left waiting behind a failure */
+        free(batch.finished[i]);
+    }
+    free(batch.finished);
+    free(workers);
+    if ((batch.file != NULL) && (fclose(batch.file) != 0) && (batch.failure == 0)){
+        batch.failure = -2;
+    }
+    *pWritten = batch.nextToWrite;
+    return (batch.failure == 0) ? 1 : batch.failure;
+}
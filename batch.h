@@ -0,0 +1,31 @@
+/*
+ * This module generates batches of boards into files, on a pool of worker threads,
+ * for building collections of boards offline.
+ * Every board is filled with a random solution by the native search, and left with a number of its cells.
+ * Board number i of a batch is drawn from stream i of the seed of the batch, so the boards depend
+ * only on the seed, and not on the number of threads or on which thread made which board.
+ */
+
+#ifndef SOFTWAREPROJECTFINALPROJECT_BATCH_H
+#define SOFTWAREPROJECTFINALPROJECT_BATCH_H
+
+#define BATCH_MAX_LEN 36 /* the longest board of a batch, so its memory stays small and its search ends in seconds */
+
+/*
+ * This function generates count boards of m*n blocks, each with filled cells left, drawn from seed,
+ * on threads worker threads (one per online processor if threads == 0).
+ * If path is a directory, board number i is written to the file i.txt in it, and otherwise all boards
+ * are written to the file at path, one after the other with an empty line between them.
+ * Either way they are written in the format of the save command with their cells fixed,
+ * in the order of their numbers, each as soon as all the boards before it were written.
+ * The number of boards written is returned through *pWritten.
+ * Requires: m * n <= BATCH_MAX_LEN.
+ * Return values:
+ * -3: the budget of the command ran out.
+ * -2: a file could not be opened or written.
+ * -1: memory allocation failed.
+ *  1: all boards were written.
+ */
+int generateBatch(int m, int n, int count, int filled, unsigned long seed, char *path, int threads, int *pWritten);
+
+#endif
@@ -5,11 +5,17 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "main_aux.h"
 #include "game.h"
 #include "parser.h"
 #include "util/board_manager.h"
-#include "util/linked_list.h"
+#include "util/moves_list.h"
+#include "backend.h"
+#include "batch.h"
+#include "util/random.h"
+#include "util/budget.h"
+#include "util/solver_stats.h"
 
 static enum Mode mode = Init;
 static int addMarks = 1;
@@ -63,18 +69,17 @@ int inputNumFromFile(FILE *file, int *pNum){
 int createBoardFromFile(char *fileName, enum Mode mode1, struct sudokuManager *board){
     int n, m, i, j, success, value, *onlyFixed;
     FILE *file = NULL;
-    struct movesList *linkedList;
+    struct movesList *movesList;
     char nextChar;
 
-    linkedList = (struct movesList*)malloc(sizeof(struct movesList));
-    if (linkedList == NULL) {
+    movesList = (struct movesList*)malloc(sizeof(struct movesList));
+    if (movesList == NULL) {
         return -1;
     }
 
-    initList(linkedList);
-    board->linkedList = linkedList;
-    linkedList->board = board;
-    /* linkedList is allocated */
+    initMovesList(movesList);
+    board->movesList = movesList;
+    /* movesList is allocated */
 
     if((mode1 == Edit) && (fileName == NULL)) {
         /* we have been called by edit command and no fileName was received */
@@ -316,6 +321,9 @@ int save(struct sudokuManager *board, char* fileName){
     else if (valid == -2){ /* Gurobi failed */
         printGurobiFailedTryAgain();
     }
+    else if (valid == -3){
+        printBudgetExhausted();
+    }
     return 0;
 }
 
@@ -327,8 +335,9 @@ int save(struct sudokuManager *board, char* fileName){
  * Each change that has been made in that board will be printed in a message.
  */
 void undo(struct sudokuManager *board){
-    int res, row, col;
-    if (board->linkedList->prev == NULL){
+    int res, count;
+    struct move *move;
+    if (board->movesList->current == 0){
         printNoPrevMoveError();
     }
     else {
@@ -338,9 +347,8 @@ void undo(struct sudokuManager *board){
         }
         else{
             if (res == 1){
-                row = board->linkedList->next->row;
-                col = board->linkedList->next->col;
-                updateErroneousBoardCell(board->board, board->erroneous, board->m, board->n, row, col);
+                move = batchMoves(board->movesList, board->movesList->current, &count);
+                updateErroneousBoardCell(board->board, board->erroneous, board->m, board->n, move->row, move->col);
             }
         }
         printBoard(board);
@@ -353,8 +361,9 @@ void undo(struct sudokuManager *board){
  * Each change that has been made in that board will be printed in a message.
  */
 void redo(struct sudokuManager *board){
-    int res, row, col;
-    if (board->linkedList->next == NULL){
+    int res, count;
+    struct move *move;
+    if (board->movesList->current == board->movesList->numBatches){
         printNoNextMoveError();
     }
     else {
@@ -364,26 +373,57 @@ void redo(struct sudokuManager *board){
         }
         else{
             if (res == 1){
-                row = board->linkedList->prev->row;
-                col = board->linkedList->prev->col;
-                updateErroneousBoardCell(board->board, board->erroneous, board->m, board->n, row, col);
+                move = batchMoves(board->movesList, board->movesList->current - 1, &count);
+                updateErroneousBoardCell(board->board, board->erroneous, board->m, board->n, move->row, move->col);
             }
         }
         printBoard(board);
     }
 }
 
+/*
+ * This function updates the erroneous board after the board went from the state after batch from
+ * to the state after batch to. Only cells changed by the moves between them may differ,
+ * so as long as there are few of them only their rows, columns and blocks are checked.
+ */
+void updateErroneousBetweenBatches(struct sudokuManager *board, int from, int to){
+    struct movesList *list = board->movesList;
+    int first = batchStart(list, (from < to) ? from : to), last = batchStart(list, (from < to) ? to : from), k;
+    if (3 * (last - first) >= boardLen(board)){ /* checking a cell's neighbours costs about 3/N of the board */
+        updateErroneousBoard(board->board, board->erroneous, board->m, board->n);
+        return;
+    }
+    for (k = first; k < last; k++){
+        updateErroneousBoardCell(board->board, board->erroneous, board->m, board->n,
+                                 list->moves[k].row, list->moves[k].col);
+    }
+}
+
 /*
  * This function resets the board to its initial state by undoing all moves.
  * This function will not change the moves list, but moving the pointer to its beginning.
 */
 void reset(struct sudokuManager *board){
-    pointToFirstMoveInMovesList(board, 0);
-    updateErroneousBoard(board->board, board->erroneous, board->m, board->n);
+    int from = board->movesList->current;
+    goToBatch(board, 0);
+    updateErroneousBetweenBatches(board, from, 0);
     printReset();
     printBoard(board);
 }
 
+/*
+ * This function brings the board to its state after the first move moves, which undo and redo
+ * can still go on from. Move 0 is the initial state.
+ * Requires: 0 <= move <= the number of moves in the moves list.
+ */
+void goToMove(struct sudokuManager *board, int move){
+    int from = board->movesList->current;
+    goToBatch(board, move);
+    updateErroneousBetweenBatches(board, from, move);
+    printWentToMove(move, board->movesList->numBatches);
+    printBoard(board);
+}
+
 /* BOARD CHANGING RELATED FUNCTIONS  */
 
 /*
@@ -392,21 +432,21 @@ void reset(struct sudokuManager *board){
  * It returns -1 if we need to terminate, and 0 otherwise.
  */
 int set(struct sudokuManager *manager, int col, int row, int val){
+    int prevVal;
     col--, row--;
+    prevVal = manager->board[matIndex(manager->m, manager->n, row, col)];
     if(isFixedCell(manager, row, col)){
         printErrorCellXYIsFixed(row, col);
         return 0;
     }
-    else if ((doSet(manager, row, col, val) == -1) ||
-             (createNextNode(manager, separator, 0, 0, 0, 0) == -1)) {
+    else if ((doSet(manager, row, col, val) == -1) || (endMovesBatch(manager) == -1)) {
         printAllocFailed();
         return -1;
     }
     else {
-        goToNextNode(manager);
         updateErroneousBoardCell(manager->board, manager->erroneous,
                                 manager->m, manager->n, row, col);
-        printActionWasMade(row, col, manager->linkedList->prev->prevValue, val);
+        printActionWasMade(row, col, prevVal, val);
         printBoard(manager);
         return 0;
     }
@@ -458,6 +498,10 @@ int validate(struct sudokuManager *board){
         printGurobiFailedTryAgain();
         return 0;
     }
+    else if(isValid == -3){
+        printBudgetExhausted();
+        return 0;
+    }
     else{
         if (isValid == -1){
             printAllocFailed();
@@ -493,6 +537,16 @@ int hint(struct sudokuManager *board, int col, int row){
         return -1; /* allocation failed */
     }
     else
+    if(ret == -2){
+        printGurobiFailedTryAgain();
+        return 0;
+    }
+    else
+    if(ret == -3){
+        printBudgetExhausted();
+        return 0;
+    }
+    else
     if(ret == 0){
         printBoardNotValidError();
         return 0;
@@ -506,11 +560,12 @@ int hint(struct sudokuManager *board, int col, int row){
 /*
  * This function guesses a solution to the current board using LP.
  * It fills cells with probability higher than X to appear in a valid solution.
+ * The LP is solved once and rounded K times, and the rounding which filled the most cells is kept.
  * If The board is erroneous, prints an error message.
  * It returns -1 if we need to terminate, and 0 otherwise.
  */
-int guess(struct sudokuManager *board, float X){
-    int res, *retBoard;
+int guess(struct sudokuManager *board, float X, int K){
+    int res, filled, *retBoard, emptyBefore = board->emptyCells;
     if (isAnyErroneousCell(board)){
         printBoardIsErroneous();
         return 0;
@@ -521,7 +576,7 @@ int guess(struct sudokuManager *board, float X){
         return -1;
     }
 
-    res = doGuess(board, X, retBoard);
+    res = doGuess(board, X, K, retBoard);
     if (res == -1){
         printAllocFailed();
         free(retBoard);
@@ -532,25 +587,34 @@ int guess(struct sudokuManager *board, float X){
         free(retBoard);
         return 0;
     }
+    if (res == -3){
+        printBudgetExhausted();
+        free(retBoard);
+        return 0;
+    }
     if (res == 0){
         printBoardNotValidError();
         free(retBoard);
     }
     if (res == 1){
-        if (updateBoardLinkedList(board, retBoard) == -1){
+        if (updateBoardMovesList(board, retBoard) == -1){
             printAllocFailed();
             free(retBoard);
             return -1;
         }
         free(retBoard);
+        filled = emptyBefore - board->emptyCells;
         printBoard(board);
+        if (K > 1){
+            printBestGuess(K, filled);
+        }
     }
     return 0;
 }
 
 /*
- * This function generates a board from the current board by filling X random cells,
- * solving the filled board, and leaving Y cells filled.
+ * This function generates a board from the current board by filling X random empty cells with legal values,
+ * filling the rest with a random solution, and leaving Y cells filled.
  * If Generate fails the board will remain the previous board.
  * It returns -1 if we need to terminate, and 0 otherwise.
  */
@@ -576,7 +640,7 @@ int generate(struct sudokuManager **pManager, int X, int Y){
         return -1;
     }
     if (res == 1){
-        if(updateBoardLinkedList(*pManager, retBoard) == -1) {
+        if(updateBoardMovesList(*pManager, retBoard) == -1) {
             printAllocFailed();
             free(retBoard);
             return -1;
@@ -588,9 +652,271 @@ int generate(struct sudokuManager **pManager, int X, int Y){
         printGenerateFailed();
         free(retBoard);
     }
+    if (res == -3){
+        printBudgetExhausted();
+        free(retBoard);
+    }
+    return 0;
+}
+
+/*
+ * This function generates a board with a single solution from the current board, by filling it
+ * with a random solution and emptying cells while the solution stays single, until Y cells are left
+ * (or, if minimize == 1, until no cell can be emptied).
+ * If it fails the board will remain the previous board.
+ * It returns -1 if we need to terminate, and 0 otherwise.
+ */
+int generateUnique(struct sudokuManager **pManager, int Y, int minimize){
+    int *retBoard;
+    int res, givens;
+
+    if (isAnyErroneousCell(*pManager)){
+        printBoardIsErroneous();
+        return 0;
+    }
+
+    retBoard = (int*)calloc(boardArea(*pManager), sizeof(int));
+    if(retBoard == NULL){
+        printAllocFailed();
+        return -1;
+    }
+
+    res = doGenerateUnique(*pManager, Y, minimize, retBoard, &givens);
+    if (res == 1){
+        if(updateBoardMovesList(*pManager, retBoard) == -1) {
+            res = -1;
+        }
+        else{
+            printBoard(*pManager);
+            printUniqueGenerated(givens);
+        }
+    }
+    if (res == -1){ /* we need to terminate */
+        printAllocFailed();
+    }
+    if (res == 0){
+        printGenerateFailed();
+    }
+    if (res == -3){
+        printBudgetExhausted();
+    }
+    free(retBoard);
+    return (res == -1) ? -1 : 0;
+}
+
+/*
+ * This function generates count boards of m*n blocks with filled cells left into path, drawn from seed,
+ * on threads worker threads (see generateBatch in batch.h). The current board is left as it is.
+ * It returns -1 if we need to terminate, and 0 otherwise.
+ */
+int generateBatchFiles(int count, int m, int n, int filled, unsigned long seed, char *path, int threads){
+    int res, written;
+    res = generateBatch(m, n, count, filled, seed, path, threads, &written);
+    if (res == -1){
+        printAllocFailed();
+        return -1;
+    }
+    if (res == -2){
+        printBatchFileFailed(path);
+    }
+    if (res == -3){
+        printBudgetExhausted();
+    }
+    printBatchWritten(written, count, path);
     return 0;
 }
 
+/*
+ * This function generates a board with a single solution from the current board, like generateUnique with
+ * Y cells left, again and again until the hardest technique needed to solve it is target, or attempts boards were made.
+ * If it fails the board will remain the previous board.
+ * It returns -1 if we need to terminate, and 0 otherwise.
+ */
+int generateGraded(struct sudokuManager **pManager, int Y, enum gradeTechnique target, int attempts){
+    struct boardGrade grade;
+    int *retBoard;
+    int res, givens;
+
+    if (isAnyErroneousCell(*pManager)){
+        printBoardIsErroneous();
+        return 0;
+    }
+    if (boardLen(*pManager) > GRADE_MAX_LEN){
+        printGradeTooLong(GRADE_MAX_LEN);
+        return 0;
+    }
+
+    retBoard = (int*)calloc(boardArea(*pManager), sizeof(int));
+    if(retBoard == NULL){
+        printAllocFailed();
+        return -1;
+    }
+
+    res = doGenerateGraded(*pManager, Y, target, attempts, retBoard, &givens, &grade);
+    if (res == 1){
+        if(updateBoardMovesList(*pManager, retBoard) == -1) {
+            res = -1;
+        }
+        else{
+            printBoard(*pManager);
+            printUniqueGenerated(givens);
+            printBoardGrade(&grade);
+        }
+    }
+    if (res == -1){ /* we need to terminate */
+        printAllocFailed();
+    }
+    if (res == 0){
+        printGenerateFailed();
+    }
+    if (res == 2){
+        printGradeNotGenerated(gradeTechniqueName(target), attempts);
+    }
+    if (res == -3){
+        printBudgetExhausted();
+    }
+    if (res == -4){
+        printGradeTooLong(GRADE_MAX_LEN);
+    }
+    free(retBoard);
+    return (res == -1) ? -1 : 0;
+}
+
+/*
+ * This function prints how hard the board is for a person: the hardest technique needed to solve it,
+ * and how many steps it took with each technique.
+ * It prints an error if the board is erroneous, or if the techniques found out that it has no solution.
+ * It returns -1 if we need to terminate, and 0 otherwise.
+ */
+int grade(struct sudokuManager *board){
+    struct boardGrade boardGrade;
+    int res;
+
+    if (isAnyErroneousCell(board)){
+        printBoardIsErroneous();
+        return 0;
+    }
+    res = gradeBoard(board->board, board->m, board->n, &boardGrade);
+    if (res == -1){
+        printAllocFailed();
+        return -1;
+    }
+    if (res == -2){
+        printGradeTooLong(GRADE_MAX_LEN);
+    }
+    if (res == 0){
+        printBoardNotValidError();
+    }
+    if (res == 1){
+        printBoardGrade(&boardGrade);
+    }
+    return 0;
+}
+
+/*
+ * This function seeds the random numbers generate, guess and the rest of the session draw from with seed,
+ * so the same commands after it give the same boards every time, unless hasSeed == 0.
+ * Either way it prints the seed.
+ */
+void setSeed(int hasSeed, unsigned long seed){
+    if (hasSeed){
+        seedSession(seed);
+    }
+    printSessionSeed(sessionSeed());
+}
+
+/*
+ * This function selects the solver backend used by validate, hint, generate and save.
+ * It prints an error if there is no such backend, or if it is not included in this build.
+ */
+void changeBackend(char *name){
+    int res = selectBackend(name);
+    if (res == -1){
+        printUnknownBackend(name);
+    }
+    else if (res == -2){
+        printBackendNotBuilt(name);
+    }
+    else{
+        printBackendSelected(backendName());
+    }
+}
+
+/*
+ * This function sets the limit every command has on the budget named kindName
+ * (time in seconds, nodes or iterations), where 0 means there is no limit.
+ * It prints an error if there is no such budget.
+ */
+void setBudget(char *kindName, double limit){
+    if (!strcmp(kindName, "time")){
+        setBudgetLimit(timeBudget, limit);
+        printBudgetSet(kindName, limit, "seconds");
+    }
+    else if (!strcmp(kindName, "nodes")){
+        setBudgetLimit(nodeBudget, limit);
+        printBudgetSet(kindName, limit, "search nodes");
+    }
+    else if (!strcmp(kindName, "iterations")){
+        setBudgetLimit(iterationBudget, limit);
+        printBudgetSet(kindName, limit, "LP iterations");
+    }
+    else{
+        printUnknownBudget(kindName);
+    }
+}
+
+/*
+ * This function prints the statistics of every solver called so far and of the races of the race backend,
+ * and where the solver log and the model export are written.
+ */
+void showSolverStats(){
+    int kind, i, count, anyCalls = 0;
+    struct raceRecord *records;
+    struct solverTotals *totals;
+    for (kind = 0; kind < NUM_SOLVER_KINDS; kind++){
+        totals = solverStatistics((enum solverKind)kind);
+        if (totals->calls + totals->cachedCalls > 0){
+            printSolverTotals(solverKindName((enum solverKind)kind), totals);
+            anyCalls = 1;
+        }
+    }
+    if (!anyCalls){
+        printNoSolverCalls();
+    }
+    records = raceStatistics(&count);
+    for (i = 0; i < count; i++){
+        printRaceRecord(records[i].m, records[i].n, records[i].filledQuarter,
+                        records[i].wins[gurobiSide], records[i].wins[nativeSide]);
+    }
+    printSolverOutputs(solverLogPath(), modelExportPath());
+}
+
+/*
+ * This function sets the file the solver log (option "log") or the model export (option "export")
+ * is written to, or turns it off if path is "off".
+ * It prints an error if there is no such option, or if the file can not be used.
+ */
+void setSolverOutput(char *option, char *path){
+    char *file = strcmp(path, "off") ? path : NULL;
+    if (!strcmp(option, "log")){
+        if (setSolverLog(file) == -1){
+            printSolverLogFailed(path);
+            return;
+        }
+    }
+    else if (!strcmp(option, "export")){
+        if (setModelExport(file) == -1){
+            printModelExportTooLong();
+            return;
+        }
+    }
+    else{
+        printUnknownSolverStatsOption(option);
+        return;
+    }
+    printSolverOutputs(solverLogPath(), modelExportPath());
+}
+
 /*
  * This function terminates the game, and frees used resources.
  * It returns 2.
@@ -600,6 +926,9 @@ int exitGame(struct sudokuManager *board){
     if (board != NULL){
         freeBoard(board);
     }
+    releaseSolverCache();
+    releaseBackends();
+    releaseSolverStatistics();
     return 2;
 }
 
@@ -654,6 +983,10 @@ int guessHint(struct sudokuManager *board, int col, int row){
         printGurobiFailedTryAgain();
         return 0;
     }
+    if (res == -3){
+        printBudgetExhausted();
+        return 0;
+    }
     if (res == -1){
         printAllocFailed();
         return -1;
@@ -669,6 +1002,43 @@ int guessHint(struct sudokuManager *board, int col, int row){
     return 0;
 }
 
+/*
+ * This function prints the legal values of every empty cell and their scores, from a single LP solve.
+ * It prints an error if the board is erroneous.
+ * It returns -1 if we need to terminate, and 0 otherwise.
+ */
+int guessHintAll(struct sudokuManager *board){
+    int *values, *starts, res;
+    double *scores;
+    if (isAnyErroneousCell(board)){ /* board is erroneous */
+        printBoardIsErroneous();
+        return 0;
+    }
+
+    res = doGuessHintAll(board, &values, &scores, &starts);
+    if (res == -2){
+        printGurobiFailedTryAgain();
+        return 0;
+    }
+    if (res == -3){
+        printBudgetExhausted();
+        return 0;
+    }
+    if (res == -1){
+        printAllocFailed();
+        return -1;
+    }
+    if (res == 1){
+        printScoreTable(boardLen(board), values, scores, starts);
+        free(values);
+        free(scores);
+        free(starts);
+        return 0;
+    } /* res == 0 */
+    printBoardNotValidError();
+    return 0;
+}
+
 /*
  * This function prints the amount of possible solutions of the board,
  * by using exhaustive backtracking.
@@ -693,6 +1063,10 @@ int numSolutions(struct sudokuManager *board){
         printAllocFailed();
         return -1;
     }
+    else if (res == -3){
+        printBudgetExhausted();
+        return 0;
+    }
     else{
         printNumOfSolutions(res);
         return 0;
@@ -718,11 +1092,15 @@ int startGame(){
             continue;
         }
         /*The line is not blank*/
+        startBudget(); /* every command has a budget of its own */
         res = interpret(command, &board, mode);
         if (res == -1){ /* There is any error */
             if (board != NULL){
                 freeBoard(board);
             }
+            releaseSolverCache();
+            releaseBackends();
+            releaseSolverStatistics();
             return -1;
         }
         if (res == 2) { /* exit command was entered*/
@@ -68,23 +68,61 @@ int validate(struct sudokuManager *board);
 /*
  * This function guesses a solution to the current board using LP.
  * It fills cells with probability higher than X to appear in a valid solution.
+ * The LP is solved once and rounded K times, and the rounding which filled the most cells is kept.
  * If The board is erroneous, prints an error message.
  * X represents probability, therefore 0 <= X <= 1.
  * It returns -1 if we need to terminate, and 0 otherwise.
  */
-int guess(struct sudokuManager *board, float X);
+int guess(struct sudokuManager *board, float X, int K);
 
 /*
  * This function generates a sudoku board from the current board by:
- * filling X random cells, solving the filled board,
+ * filling X random empty cells with legal values, filling the rest with a random solution,
  * and leaving Y cells filled.
- * This function appempts to solve the board many time,
- * when it fails, it tries again.
- * If Generate fails all it's attempts, the board will remain the previous board.
+ * If Generate fails, the board will remain the previous board.
  * It returns -1 if we need to terminate, and 0 otherwise.
  */
 int generate(struct sudokuManager **pManager, int X, int Y);
 
+/*
+ * This function generates a sudoku board with a single solution from the current board by:
+ * filling it with a random solution, and emptying cells while the solution stays single,
+ * until Y cells are left (or, if minimize == 1, until no cell can be emptied).
+ * If it fails, the board will remain the previous board.
+ * It returns -1 if we need to terminate, and 0 otherwise.
+ */
+int generateUnique(struct sudokuManager **pManager, int Y, int minimize);
+
+/*
+ * This function generates a sudoku board with a single solution from the current board, like generateUnique with
+ * Y cells left, again and again until the hardest technique needed to solve it is target, or attempts boards were made.
+ * If it fails, the board will remain the previous board.
+ * It returns -1 if we need to terminate, and 0 otherwise.
+ */
+int generateGraded(struct sudokuManager **pManager, int Y, enum gradeTechnique target, int attempts);
+
+/*
+ * This function prints how hard the board is for a person: the hardest technique needed to solve it,
+ * and how many steps it took with each technique.
+ * It prints an error if the board is erroneous, or if the techniques found out that it has no solution.
+ * It returns -1 if we need to terminate, and 0 otherwise.
+ */
+int grade(struct sudokuManager *board);
+
+/*
+ * This function seeds the random numbers generate, guess and the rest of the session draw from with seed,
+ * so the same commands after it give the same boards every time, unless hasSeed == 0.
+ * Either way it prints the seed.
+ */
+void setSeed(int hasSeed, unsigned long seed);
+
+/*
+ * This function generates count boards of m*n blocks with filled cells left into path, drawn from seed,
+ * on threads worker threads (see generateBatch in batch.h). The current board is left as it is.
+ * It returns -1 if we need to terminate, and 0 otherwise.
+ */
+int generateBatchFiles(int count, int m, int n, int filled, unsigned long seed, char *path, int threads);
+
 /*
  * This function undoes a move previously done by the user.
  * If there is no move to undo (the board is in it's initial state),
@@ -117,6 +155,13 @@ int hint(struct sudokuManager *board, int col, int row);
  */
 int guessHint(struct sudokuManager *board, int col, int row);
 
+/*
+ * This function prints the legal values of every empty cell and their scores, from a single LP solve.
+ * It prints an error if the board is erroneous.
+ * It returns -1 if we need to terminate, and 0 otherwise.
+ */
+int guessHintAll(struct sudokuManager *board);
+
 /*
  * This function prints the amount of possible solutions of the board.
  * It returns -1 if we need to terminate, and 0 otherwise.
@@ -136,6 +181,39 @@ int autofill(struct sudokuManager *board);
  */
 void reset(struct sudokuManager *board);
 
+/*
+ * This function brings the board to its state after the first move moves, which undo and redo
+ * can still go on from. Move 0 is the initial state.
+ * Requires: 0 <= move <= the number of moves in the moves list.
+ */
+void goToMove(struct sudokuManager *board, int move);
+
+/*
+ * This function selects the solver backend used by validate, hint, generate and save.
+ * It prints an error if there is no such backend, or if it is not included in this build.
+ */
+void changeBackend(char *name);
+
+/*
+ * This function sets the limit every command has on the budget named kindName
+ * (time in seconds, nodes or iterations), where 0 means there is no limit.
+ * It prints an error if there is no such budget.
+ */
+void setBudget(char *kindName, double limit);
+
+/*
+ * This function prints the statistics of every solver called so far and of the races of the race backend,
+ * and where the solver log and the model export are written.
+ */
+void showSolverStats();
+
+/*
+ * This function sets the file the solver log (option "log") or the model export (option "export")
+ * is written to, or turns it off if path is "off".
+ * It prints an error if there is no such option, or if the file can not be used.
+ */
+void setSolverOutput(char *option, char *path);
+
 /*
  * This function terminates the game, and frees used resources.
  * It returns 2.
@@ -0,0 +1,716 @@
+/*
+ * This module grades how hard a board is for a person, without any search.
+ * It solves the board the way people do, by a ladder of techniques from the simplest up:
+ * at every step it applies the simplest technique which places a value or rules out candidates,
+ * and the grade of the board is the hardest technique it needed, and how many steps it took.
+ * Boards the techniques can not finish are graded as needing search.
+ * Naked subsets, hidden subsets and fish are all the same search: k of the units (cells, values or lines)
+ * whose options are k between them, which rules those options out of every other unit.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "grader.h"
+#include "util/board_manager.h"
+
+#define GRADE_MAX_SUBSET 4 /* subsets and fish are looked for up to quads and jellyfish */
+
+/*
+ * The state of a board being graded.
+ * Values are kept 0-based inside the grader (value v is stored as v + 1 in board),
+ * and the candidates of a cell are a bitmask of its values.
+ * Unit u is row u for u < N, column u - N for u < 2N, and block u - 2N otherwise.
+ */
+struct gradeState {
+    int m;
+    int n;
+    int N;
+    int area;
+    unsigned long full; /* the mask of all N values */
+    int *board; /* area cells, 0 for an empty cell */
+    unsigned long *cand; /* the candidates of every cell, 0 for a filled cell */
+    int *units; /* units[u * N + k] is the k'th cell of unit u */
+    int *blockOf; /* the block number of every cell */
+    int empty; /* the number of empty cells */
+    int *unitCount; /* scratch: 3N counts */
+    int *color; /* scratch: area colors */
+    int *queue; /* scratch: area cells */
+    int *seen; /* scratch: 2 * area stamps */
+    int stamp; /* the last stamp used in seen */
+    int *peers; /* scratch: 3N cells */
+    unsigned long *masks; /* scratch: N masks */
+};
+
+/*
+ * A search for k masks, each with 2 to k bits, whose union has k bits and meets some other mask.
+ */
+struct gradeSubset {
+    unsigned long *masks;
+    int count;
+    int k;
+    int eligible[GRADE_MAX_LEN]; /* the positions of the masks with 2 to k bits */
+    int numEligible;
+    unsigned long chosen; /* the masks found, as a bitmask of their positions */
+    unsigned long unionMask; /* the union of the masks found */
+};
+
+/*
+ * This method returns the number of bits set in x.
+ */
+int gradeBitCount(unsigned long x){
+    int count = 0;
+    while (x != 0){
+        x &= x - 1;
+        count++;
+    }
+    return count;
+}
+
+/*
+ * This method returns the position of the lowest bit set in x, which is not 0.
+ */
+int gradeLowestBit(unsigned long x){
+    int i = 0;
+    while (!((x >> i) & 1UL)){
+        i++;
+    }
+    return i;
+}
+
+/*
+ * This method returns the unit of the given type (0 for its row, 1 for its column and 2 for its block) of cell.
+ */
+int gradeUnitOf(struct gradeState *g, int cell, int type){
+    if (type == 0){
+        return cell / g->N;
+    }
+    if (type == 1){
+        return g->N + cell % g->N;
+    }
+    return 2 * g->N + g->blockOf[cell];
+}
+
+/*
+ * This method returns 1 if cell is in unit u, and 0 otherwise.
+ */
+int gradeInUnit(struct gradeState *g, int cell, int u){
+    return gradeUnitOf(g, cell, u / g->N) == u;
+}
+
+/*
+ * This method returns 1 if cells a and b are different cells of the same row, column or block, and 0 otherwise.
+ */
+int gradeSees(struct gradeState *g, int a, int b){
+    return (a != b) && ((a / g->N == b / g->N) || (a % g->N == b % g->N) || (g->blockOf[a] == g->blockOf[b]));
+}
+
+/*
+ * This method rules the values of mask out of the candidates of cell.
+ * It returns 1 if any of them was a candidate, and 0 otherwise.
+ */
+int gradeEliminate(struct gradeState *g, int cell, unsigned long mask){
+    if ((g->cand[cell] & mask) == 0){
+        return 0;
+    }
+    g->cand[cell] &= ~mask;
+    return 1;
+}
+
+/*
+ * This function places value v (0-based) in cell, and rules it out of every cell which sees it.
+ */
+void gradePlace(struct gradeState *g, int cell, int v){
+    int type, k, u;
+    g->board[cell] = v + 1;
+    g->cand[cell] = 0;
+    g->empty--;
+    for (type = 0; type < 3; type++){
+        u = gradeUnitOf(g, cell, type);
+        for (k = 0; k < g->N; k++){
+            g->cand[g->units[u * g->N + k]] &= ~(1UL << v);
+        }
+    }
+}
+
+/*
+ * This function frees the arrays of g.
+ */
+void freeGradeState(struct gradeState *g){
+    free(g->board);
+    free(g->cand);
+    free(g->units);
+    free(g->blockOf);
+    free(g->unitCount);
+    free(g->color);
+    free(g->queue);
+    free(g->seen);
+    free(g->peers);
+    free(g->masks);
+}
+
+/*
+ * This function initializes g to the board of m*n blocks, with the candidates of every empty cell.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: a value is twice in a row/column/block.
+ *  1: g was initialized.
+ */
+int initGradeState(struct gradeState *g, int *board, int m, int n){
+    int N = m * n, area = N * N, b, i, j, k, row, col, cell;
+
+    g->m = m;
+    g->n = n;
+    g->N = N;
+    g->area = area;
+    g->full = ((1UL << (N - 1)) << 1) - 1; /* not 1UL << N, which is undefined once N is the word length */
+    g->stamp = 0;
+    g->board = (int *)malloc(area * sizeof(int));
+    g->cand = (unsigned long *)malloc(area * sizeof(unsigned long));
+    g->units = (int *)malloc(3 * area * sizeof(int));
+    g->blockOf = (int *)malloc(area * sizeof(int));
+    g->unitCount = (int *)malloc(3 * N * sizeof(int));
+    g->color = (int *)malloc(area * sizeof(int));
+    g->queue = (int *)malloc(area * sizeof(int));
+    g->seen = (int *)calloc(2 * area, sizeof(int));
+    g->peers = (int *)malloc(3 * N * sizeof(int));
+    g->masks = (unsigned long *)malloc(N * sizeof(unsigned long));
+    if ((g->board == NULL) || (g->cand == NULL) || (g->units == NULL) || (g->blockOf == NULL) ||
+        (g->unitCount == NULL) || (g->color == NULL) || (g->queue == NULL) || (g->seen == NULL) ||
+        (g->peers == NULL) || (g->masks == NULL)){
+        freeGradeState(g);
+        return -1;
+    }
+
+    for (i = 0; i < N; i++){
+        for (k = 0; k < N; k++){
+            g->units[i * N + k] = i * N + k;
+            g->units[(N + i) * N + k] = k * N + i;
+        }
+    }
+    for (b = 0; b < N; b++){
+        getFirstIndexInBlock(m, n, b, &row, &col);
+        for (i = 0; i < m; i++){
+            for (j = 0; j < n; j++){
+                cell = matIndex(m, n, row + i, col + j);
+                g->units[(2 * N + b) * N + i * n + j] = cell;
+                g->blockOf[cell] = b;
+            }
+        }
+    }
+
+    g->empty = area;
+    for (cell = 0; cell < area; cell++){
+        g->board[cell] = 0;
+        g->cand[cell] = g->full;
+    }
+    for (cell = 0; cell < area; cell++){
+        if (board[cell] == 0){
+            continue;
+        }
+        if (!(g->cand[cell] & (1UL << (board[cell] - 1)))){ /* a cell it sees already has the value */
+            return 0;
+        }
+        gradePlace(g, cell, board[cell] - 1);
+    }
+    return 1;
+}
+
+/* TECHNIQUES */
+
+/*
+ * Every technique applies itself once, and returns 1 if it placed a value or ruled out candidates,
+ * 0 if it found nothing to do, and -1 if it found out that the board has no solution.
+ */
+
+/*
+ * This method places a value in a cell which has it as its only candidate.
+ */
+int gradeNakedSingle(struct gradeState *g){
+    int cell;
+    for (cell = 0; cell < g->area; cell++){
+        if (g->board[cell] != 0){
+            continue;
+        }
+        if (g->cand[cell] == 0){
+            return -1;
+        }
+        if ((g->cand[cell] & (g->cand[cell] - 1)) == 0){
+            gradePlace(g, cell, gradeLowestBit(g->cand[cell]));
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * This method places a value in the only cell of a row/column/block which can still hold it.
+ */
+int gradeHiddenSingle(struct gradeState *g){
+    int u, k, v, cell, N = g->N;
+    unsigned long placed, once, twice;
+    for (u = 0; u < 3 * N; u++){
+        placed = once = twice = 0;
+        for (k = 0; k < N; k++){
+            cell = g->units[u * N + k];
+            if (g->board[cell] != 0){
+                placed |= 1UL << (g->board[cell] - 1);
+            }
+            else{
+                twice |= once & g->cand[cell];
+                once |= g->cand[cell];
+            }
+        }
+        if (g->full & ~placed & ~once){ /* a value with no cell left */
+            return -1;
+        }
+        if (once & ~twice){
+            v = gradeLowestBit(once & ~twice);
+            for (k = 0; !(g->cand[g->units[u * N + k]] & (1UL << v)); k++);
+            gradePlace(g, g->units[u * N + k], v);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * This method looks at the intersection of block unit b and line unit line:
+ * a value the block has only in the intersection is ruled out of the rest of the line (pointing),
+ * and a value the line has only in the intersection is ruled out of the rest of the block (claiming).
+ * It returns 1 if any candidate was ruled out, and 0 otherwise.
+ */
+int gradeLockedIn(struct gradeState *g, int b, int line){
+    int k, cell, N = g->N, res = 0;
+    unsigned long inter = 0, restBlock = 0, restLine = 0, pointing, claiming;
+    for (k = 0; k < N; k++){
+        cell = g->units[b * N + k];
+        if (gradeInUnit(g, cell, line)){
+            inter |= g->cand[cell];
+        }
+        else{
+            restBlock |= g->cand[cell];
+        }
+        cell = g->units[line * N + k];
+        if (!gradeInUnit(g, cell, b)){
+            restLine |= g->cand[cell];
+        }
+    }
+    pointing = inter & ~restBlock & restLine;
+    claiming = inter & ~restLine & restBlock;
+    for (k = 0; k < N; k++){
+        cell = g->units[line * N + k];
+        if (pointing && !gradeInUnit(g, cell, b)){
+            res |= gradeEliminate(g, cell, pointing);
+        }
+        cell = g->units[b * N + k];
+        if (claiming && !gradeInUnit(g, cell, line)){
+            res |= gradeEliminate(g, cell, claiming);
+        }
+    }
+    return res;
+}
+
+/*
+ * This method rules out candidates by a value of a block confined to a row/column, or the other way around.
+ */
+int gradeLockedCandidates(struct gradeState *g){
+    int b, i, row, col, N = g->N;
+    for (b = 0; b < N; b++){
+        getFirstIndexInBlock(g->m, g->n, b, &row, &col);
+        for (i = 0; i < g->m; i++){
+            if (gradeLockedIn(g, 2 * N + b, row + i)){
+                return 1;
+            }
+        }
+        for (i = 0; i < g->n; i++){
+            if (gradeLockedIn(g, 2 * N + b, N + col + i)){
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * This method searches s for size more masks from eligible position start on, on top of the masks chosen so far
+ * and their union unionMask. It returns 1 if it found them, and 0 otherwise.
+ */
+int gradeSearchSubset(struct gradeSubset *s, int start, int size, unsigned long chosen, unsigned long unionMask){
+    int i;
+    unsigned long grown;
+    if (size == s->k){
+        if (gradeBitCount(unionMask) != s->k){
+            return 0;
+        }
+        for (i = 0; i < s->count; i++){ /* the subset is only of use if it rules something out */
+            if (!((chosen >> i) & 1UL) && (s->masks[i] & unionMask)){
+                s->chosen = chosen;
+                s->unionMask = unionMask;
+                return 1;
+            }
+        }
+        return 0;
+    }
+    for (i = start; i <= s->numEligible - (s->k - size); i++){
+        grown = unionMask | s->masks[s->eligible[i]];
+        if ((gradeBitCount(grown) <= s->k) &&
+            gradeSearchSubset(s, i + 1, size + 1, chosen | (1UL << s->eligible[i]), grown)){
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * This method looks for k of the count masks, each with 2 to k bits, whose union has k bits
+ * and meets some other mask, into s, for the smallest k up to GRADE_MAX_SUBSET there is.
+ * It returns 1 if it found them, and 0 otherwise.
+ */
+int gradeFindSubset(struct gradeSubset *s, unsigned long *masks, int count){
+    int i, bits, nonEmpty;
+    s->masks = masks;
+    s->count = count;
+    for (s->k = 2; s->k <= GRADE_MAX_SUBSET; s->k++){
+        s->numEligible = 0;
+        for (nonEmpty = 0, i = 0; i < count; i++){
+            bits = gradeBitCount(masks[i]);
+            nonEmpty += (bits > 0);
+            if ((bits >= 2) && (bits <= s->k)){
+                s->eligible[s->numEligible++] = i;
+            }
+        }
+        if (nonEmpty <= s->k){ /* no mask is left to rule anything out of */
+            return 0;
+        }
+        if ((s->numEligible >= s->k) && gradeSearchSubset(s, 0, 0, 0, 0)){
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * This method rules out candidates by k cells of a unit with k candidates between them:
+ * those candidates are ruled out of the other cells of the unit.
+ */
+int gradeNakedSubset(struct gradeState *g){
+    struct gradeSubset s;
+    int u, i, N = g->N;
+    for (u = 0; u < 3 * N; u++){
+        for (i = 0; i < N; i++){
+            g->masks[i] = g->cand[g->units[u * N + i]];
+        }
+        if (gradeFindSubset(&s, g->masks, N)){
+            for (i = 0; i < N; i++){
+                if (!((s.chosen >> i) & 1UL)){
+                    gradeEliminate(g, g->units[u * N + i], s.unionMask);
+                }
+            }
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * This method rules out candidates by k values of a unit with k cells between them:
+ * the other candidates of those cells are ruled out.
+ */
+int gradeHiddenSubset(struct gradeState *g){
+    struct gradeSubset s;
+    int u, i, N = g->N;
+    unsigned long c;
+    for (u = 0; u < 3 * N; u++){
+        for (i = 0; i < N; i++){
+            g->masks[i] = 0;
+        }
+        for (i = 0; i < N; i++){ /* the positions in the unit of every value */
+            for (c = g->cand[g->units[u * N + i]]; c != 0; c &= c - 1){
+                g->masks[gradeLowestBit(c)] |= 1UL << i;
+            }
+        }
+        if (gradeFindSubset(&s, g->masks, N)){
+            for (i = 0; i < N; i++){
+                if ((s.unionMask >> i) & 1UL){
+                    gradeEliminate(g, g->units[u * N + i], ~s.chosen);
+                }
+            }
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * This method rules out candidates by a value of k rows with k columns between them
+ * (or of k columns with k rows between them): the value is ruled out of the rest of those columns (rows).
+ */
+int gradeFish(struct gradeState *g){
+    struct gradeSubset s;
+    int v, base, i, j, N = g->N;
+    for (v = 0; v < N; v++){
+        for (base = 0; base < 2 * N; base += N){ /* rows, then columns */
+            for (i = 0; i < N; i++){ /* the positions of v in every line */
+                g->masks[i] = 0;
+                for (j = 0; j < N; j++){
+                    if (g->cand[g->units[(base + i) * N + j]] & (1UL << v)){
+                        g->masks[i] |= 1UL << j;
+                    }
+                }
+            }
+            if (gradeFindSubset(&s, g->masks, N)){
+                for (i = 0; i < N; i++){
+                    for (j = 0; j < N; j++){
+                        if (!((s.chosen >> i) & 1UL) && ((s.unionMask >> j) & 1UL)){
+                            gradeEliminate(g, g->units[(base + i) * N + j], 1UL << v);
+                        }
+                    }
+                }
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * This method colors the conjugate pairs of value v (the two cells of a unit which can still hold it)
+ * into chains of two alternating colors, chain c being colored 2c and 2c + 1, into g->color.
+ * A color seen twice in a unit is false, and a cell which sees both colors of a chain can not hold v.
+ * It returns 1 if any candidate was ruled out, and 0 otherwise.
+ */
+int gradeColoring(struct gradeState *g, int v){
+    int u, k, type, cell, other, head, tail, chains = 0, res = 0, N = g->N;
+    unsigned long bit = 1UL << v;
+
+    for (u = 0; u < 3 * N; u++){
+        for (g->unitCount[u] = 0, k = 0; k < N; k++){
+            g->unitCount[u] += (g->cand[g->units[u * N + k]] & bit) != 0;
+        }
+    }
+    for (cell = 0; cell < g->area; cell++){
+        g->color[cell] = -1;
+    }
+    for (cell = 0; cell < g->area; cell++){
+        if (!(g->cand[cell] & bit) || (g->color[cell] != -1)){
+            continue;
+        }
+        g->color[cell] = 2 * chains++;
+        g->queue[0] = cell;
+        for (head = 0, tail = 1; head < tail; head++){
+            for (type = 0; type < 3; type++){
+                u = gradeUnitOf(g, g->queue[head], type);
+                if (g->unitCount[u] != 2){
+                    continue;
+                }
+                for (k = 0; k < N; k++){
+                    other = g->units[u * N + k];
+                    if ((other != g->queue[head]) && (g->cand[other] & bit) && (g->color[other] == -1)){
+                        g->color[other] = g->color[g->queue[head]] ^ 1;
+                        g->queue[tail++] = other;
+                    }
+                }
+            }
+        }
+    }
+
+    for (u = 0; u < 3 * N; u++){ /* a color twice in a unit */
+        g->stamp++;
+        for (k = 0; k < N; k++){
+            cell = g->units[u * N + k];
+            if (!(g->cand[cell] & bit)){
+                continue;
+            }
+            if (g->seen[g->color[cell]] == g->stamp){
+                for (other = 0; other < g->area; other++){
+                    if (g->color[other] == g->color[cell]){
+                        gradeEliminate(g, other, bit);
+                    }
+                }
+                return 1;
+            }
+            g->seen[g->color[cell]] = g->stamp;
+        }
+    }
+    for (cell = 0; cell < g->area; cell++){ /* a cell which sees both colors of another chain */
+        if (!(g->cand[cell] & bit)){
+            continue;
+        }
+        g->stamp++;
+        for (type = 0; type < 3; type++){
+            u = gradeUnitOf(g, cell, type);
+            for (k = 0; k < N; k++){
+                other = g->units[u * N + k];
+                if ((other == cell) || !(g->cand[other] & bit) || (g->color[other] / 2 == g->color[cell] / 2)){
+                    continue;
+                }
+                g->seen[g->color[other]] = g->stamp;
+                if (g->seen[g->color[other] ^ 1] == g->stamp){
+                    res |= gradeEliminate(g, cell, bit);
+                }
+            }
+        }
+    }
+    return res;
+}
+
+/*
+ * This method rules out candidates by an XY-wing: a pivot with candidates {x, y}, which sees
+ * a cell with {x, z} and a cell with {y, z}; z is ruled out of every cell which sees both of them.
+ * It returns 1 if any candidate was ruled out, and 0 otherwise.
+ */
+int gradeXYWing(struct gradeState *g){
+    int pivot, type, k, i, j, cell, a, b, numPeers, res = 0, N = g->N;
+    unsigned long p, z;
+    for (pivot = 0; pivot < g->area; pivot++){
+        p = g->cand[pivot];
+        if (gradeBitCount(p) != 2){
+            continue;
+        }
+        for (numPeers = 0, type = 0; type < 3; type++){ /* the cells with two candidates the pivot sees */
+            for (k = 0; k < N; k++){
+                cell = g->units[gradeUnitOf(g, pivot, type) * N + k];
+                if ((cell == pivot) || (gradeBitCount(g->cand[cell]) != 2) ||
+                    ((type == 2) && ((cell / N == pivot / N) || (cell % N == pivot % N)))){
+                    continue;
+                }
+                g->peers[numPeers++] = cell;
+            }
+        }
+        for (i = 0; i < numPeers; i++){
+            for (j = i + 1; j < numPeers; j++){
+                a = g->peers[i];
+                b = g->peers[j];
+                z = g->cand[a] & g->cand[b] & ~p;
+                if ((gradeBitCount(g->cand[a] & p) != 1) || (gradeBitCount(g->cand[b] & p) != 1) ||
+                    ((g->cand[a] & p) == (g->cand[b] & p)) || (gradeBitCount(z) != 1)){
+                    continue;
+                }
+                for (cell = 0; cell < g->area; cell++){
+                    if ((cell != a) && (cell != b) && gradeSees(g, cell, a) && gradeSees(g, cell, b)){
+                        res |= gradeEliminate(g, cell, z);
+                    }
+                }
+                if (res){
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * This method rules out candidates by simple coloring of a value, or else by an XY-wing.
+ */
+int gradeChain(struct gradeState *g){
+    int v;
+    for (v = 0; v < g->N; v++){
+        if (gradeColoring(g, v)){
+            return 1;
+        }
+    }
+    return gradeXYWing(g);
+}
+
+/*
+ * This method applies technique once to g.
+ * It returns 1 if it placed a value or ruled out candidates, 0 if it found nothing to do,
+ * and -1 if it found out that the board has no solution.
+ */
+int applyGradeTechnique(struct gradeState *g, enum gradeTechnique technique){
+    switch (technique){
+        case nakedSingle:
+            return gradeNakedSingle(g);
+        case hiddenSingle:
+            return gradeHiddenSingle(g);
+        case lockedCandidates:
+            return gradeLockedCandidates(g);
+        case nakedSubset:
+            return gradeNakedSubset(g);
+        case hiddenSubset:
+            return gradeHiddenSubset(g);
+        case fish:
+            return gradeFish(g);
+        case chain:
+            return gradeChain(g);
+        default:
+            return 0;
+    }
+}
+
+/* GRADE */
+
+/*
+ * This function grades board, of m*n blocks, into *grade. board is not changed.
+ * Return values:
+ * -2: the board is longer than GRADE_MAX_LEN.
+ * -1: memory allocation failed.
+ *  0: the board has no solution, which the techniques found out.
+ *  1: the board was graded.
+ */
+int gradeBoard(int *board, int m, int n, struct boardGrade *grade){
+    struct gradeState g;
+    int t, res;
+
+    if (m * n > GRADE_MAX_LEN){
+        return -2;
+    }
+    grade->hardest = nakedSingle;
+    grade->steps = 0;
+    for (t = 0; t < NUM_GRADE_TECHNIQUES; t++){
+        grade->stepsBy[t] = 0;
+    }
+    res = initGradeState(&g, board, m, n);
+    if (res == -1){
+        return -1;
+    }
+    while ((res == 1) && (g.empty > 0)){
+        for (t = nakedSingle; t < searchNeeded; t++){ /* the simplest technique which does anything */
+            res = applyGradeTechnique(&g, (enum gradeTechnique)t);
+            if (res != 0){
+                break;
+            }
+        }
+        if (t == searchNeeded){ /* the techniques got stuck */
+            grade->hardest = searchNeeded;
+            res = 1;
+            break;
+        }
+        if (res == 1){
+            grade->steps++;
+            grade->stepsBy[t]++;
+            if (t > (int)grade->hardest){
+                grade->hardest = (enum gradeTechnique)t;
+            }
+        }
+    }
+    freeGradeState(&g);
+    return (res == -1) ? 0 : res;
+}
+
+/* TECHNIQUE NAMES */
+
+static char *gradeTechniqueNames[NUM_GRADE_TECHNIQUES] = {"naked_single", "hidden_single", "locked_candidates",
+                                                          "naked_subset", "hidden_subset", "fish", "chain",
+                                                          "search"};
+
+/*
+ * This method returns the name of technique.
+ */
+char *gradeTechniqueName(enum gradeTechnique technique){
+    return gradeTechniqueNames[technique];
+}
+
+/*
+ * This method returns the technique named name, or -1 if there is no such technique.
+ */
+int gradeTechniqueByName(char *name){
+    int t;
+    for (t = 0; t < NUM_GRADE_TECHNIQUES; t++){
+        if (!strcmp(name, gradeTechniqueNames[t])){
+            return t;
+        }
+    }
+    return -1;
+}
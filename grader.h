@@ -0,0 +1,55 @@
+/*
+ * This module grades how hard a board is for a person, without any search.
+ * It solves the board the way people do, by a ladder of techniques from the simplest up:
+ * at every step it applies the simplest technique which places a value or rules out candidates,
+ * and the grade of the board is the hardest technique it needed, and how many steps it took.
+ * Boards the techniques can not finish are graded as needing search.
+ */
+
+#ifndef SOFTWAREPROJECTFINALPROJECT_GRADER_H
+#define SOFTWAREPROJECTFINALPROJECT_GRADER_H
+
+/*
+ * The techniques of the ladder, from the simplest.
+ */
+enum gradeTechnique {
+    nakedSingle = 0, /* a cell with a single candidate */
+    hiddenSingle = 1, /* a value with a single cell left in a row/column/block */
+    lockedCandidates = 2, /* a value of a unit confined to its intersection with another unit */
+    nakedSubset = 3, /* k cells of a unit with k candidates between them (pairs to quads) */
+    hiddenSubset = 4, /* k values of a unit with k cells between them (pairs to quads) */
+    fish = 5, /* a value of k rows (columns) confined to k columns (rows): X-wing, swordfish and jellyfish */
+    chain = 6, /* simple coloring of the conjugate pairs of a value, and XY-wings */
+    searchNeeded = 7 /* the techniques got stuck */
+};
+
+#define NUM_GRADE_TECHNIQUES 8
+#define GRADE_MAX_LEN 32 /* the candidates of a cell are a bitmask of an unsigned long */
+
+struct boardGrade {
+    enum gradeTechnique hardest;
+    int steps;
+    int stepsBy[NUM_GRADE_TECHNIQUES]; /* the steps each technique made */
+};
+
+/*
+ * This function grades board, of m*n blocks, into *grade. board is not changed.
+ * Return values:
+ * -2: the board is longer than GRADE_MAX_LEN.
+ * -1: memory allocation failed.
+ *  0: the board has no solution, which the techniques found out.
+ *  1: the board was graded.
+ */
+int gradeBoard(int *board, int m, int n, struct boardGrade *grade);
+
+/*
+ * This method returns the name of technique.
+ */
+char *gradeTechniqueName(enum gradeTechnique technique);
+
+/*
+ * This method returns the technique named name, or -1 if there is no such technique.
+ */
+int gradeTechniqueByName(char *name);
+
+#endif
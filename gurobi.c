@@ -2,22 +2,32 @@
  * This module is meant to deal everything that has to do with Gurobi.
  * It creates variables and constraints meant to solve the sudoku board in different ways using Gurobi
  * and has functions that use this solution in several ways.
+ * Every solve is recorded in the solver statistics (util/solver_stats.h).
  */
 
+#define _POSIX_C_SOURCE 200112L
+
 #include "gurobi.h"
+#include <pthread.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include "gurobi_c.h"
 #include "util/board_manager.h"
-#include <time.h>
+#include "util/candidate_index.h"
+#include "lp_relaxation.h"
+#include "util/budget.h"
+#include "util/solver_stats.h"
+#include "util/random.h"
+
+#define GUROBI_POOL_DEFAULT 0 /* PoolSearchMode: the solutions found on the way to the optimum */
+#define GUROBI_POOL_BEST 2 /* PoolSearchMode: the best solutions */
+#define GUROBI_DEFAULT_POOL_SOLUTIONS 10
 
 /*
- * This function is raffles a double between min and max.
+ * This function is raffles a double between min and max, from the stream of the session.
  */
 double randRangeDouble(double min, double max){
-    double range = (max - min);
-    double div = RAND_MAX / range;
-    return min + (rand() / div);
+    return min + randomUnit(sessionRandom()) * (max - min);
 }
 
 /*
@@ -29,862 +39,1205 @@ int threeDIndex(int len, int i, int j, int k){
 }
 
 /*
- * This function gets a sudokuManager, and 3 dimensional array initialized with zeros.
- * will update indices such that a cell will contain -1 if we don't want it to become a variable,
- * and otherwise with its variable index.
- * Return values: the function returns the amount of variables we need in our Gurobi program.
+ * Every cell, and every unit and value, has one constraint.
+ * Keys number them: familyKey(N, family, unit, value) for a unit of a family,
+ * which is its unitKey in a candidate index, and familyKey(N, cellFamily, row, col) for a cell.
  */
-int update3DIndices(struct sudokuManager *manager, int *indices){
-    int length = boardLen(manager);
-    int* board = manager->board;
-    int row, col, m = manager->m, n = manager->n, val = 0;
-    int i, j, height;
-    int blockRowLowBound, blockRowHighBound, blockColLowBound, blockColHighBound;
-    int count = 0;
-    for (row = 0; row < length; row++) {
-        for(col = 0; col < length; col++){
-            val = board[matIndex(m,n,row,col)];
-            if(val == 0){ /* cell is empty */
-                continue;
-            }
-            val--;
-            /* updates for all values for this cell */
-            for(height = 0; height < length; height++){
-                if(indices[threeDIndex(length, row, col, height)] == 0) {
-                    indices[threeDIndex(length, row, col, height)] = -1;
-                }
-            }
-            /* update for all row */
-            for(j = 0; j < length; j++){
-                if(indices[threeDIndex(length, row, j, val)] == 0) {
-                    indices[threeDIndex(length, row, j, val)] = -1;
-                }
-            }
-            /* update for all column */
-            for(i = 0; i < length; i++){
-                if(indices[threeDIndex(length, i, col, val)] == 0) {
-                    indices[threeDIndex(length, i, col, val)] = -1;
-                }
-            }
-            /* update for all block */
-            blockRowLowBound = rowLowBound(m, row);
-            blockRowHighBound = rowHighBound(m, row);
-            blockColLowBound = colLowBound(n, col);
-            blockColHighBound = colHighBound(n, col);
-            for(i = blockRowLowBound ; i < blockRowHighBound ; i++){
-                for(j = blockColLowBound ; j < blockColHighBound ; j++) {
-                    if(indices[threeDIndex(length, i, j, val)] == 0) {
-                        indices[threeDIndex(length, i, j, val)] = -1;
-                    }
-                }
-            }
-            /* after filling the row, column, cell and block with -1
-             * we set -2 in the cell that represents the actual
-             * value(+1) of the cell in manager->board */
-            indices[threeDIndex(length, row, col, val)] = -2;
-        }
-    }
-    for(row = 0; row < length; row++){
-        for(col = 0; col < length; col++){
-            for (height = 0; height < length ;height ++) {
-                val = indices[threeDIndex(length, row, col, height)];
-                if((val != -1)&&(val != -2)){
-                    /* only if we want to have this variable */
-                    indices[threeDIndex(length, row, col, height)] = count;
-                    /* updates in the relevant cell its variable index number */
-                    count ++;
-                }
-            }
-        }
-    }
-    return count; /* returns the amount of variables */
+enum constraintFamily {
+    rowFamily = rowUnit,
+    colFamily = colUnit,
+    blockFamily = blockUnit,
+    cellFamily = NUM_UNIT_TYPES
+};
+
+#define NUM_FAMILIES 4
+
+/*
+ * This method returns the key of the constraint of unit number unit of the given family and value v (0-based).
+ */
+int familyKey(int N, enum constraintFamily family, int unit, int v){
+    return ((int)family * N + unit) * N + v;
 }
 
 /*
- * Initializes a 3D array with zeros.
+ * This method returns the k'th candidate (0 <= k < N) that the constraint of key may contain,
+ * on an m*n board.
  */
-int *init3DArray(int length){
-    int *array = (int *)calloc(length * length * length, sizeof(int));
-    return array;
+int keyCandidate(int m, int n, int key, int k){
+    int N = m * n, unit = (key / N) % N, v = key % N, row, col;
+    switch(key / (N * N)){
+        case rowFamily:
+            return threeDIndex(N, unit, k, v);
+        case colFamily:
+            return threeDIndex(N, k, unit, v);
+        case blockFamily:
+            getFirstIndexInBlock(m, n, unit, &row, &col);
+            return threeDIndex(N, row + k / n, col + k % n, v);
+        default: /* a cell, where unit is its row and v is its column */
+            return threeDIndex(N, unit, v, k);
+    }
 }
 
 /*
- * This function updates vtype array values by the given enum of Gurobi Option.
+ * This function creates an array and fills it with double ones.
  */
-void initVariableType(GurobiOption type, char *vtype, int amountOfVariables) {
+double* onesArray(int len){
     int i;
-    switch(type) {
-        case BINARY:
-            for (i = 0; i < amountOfVariables; i++) {
-                vtype[i] = GRB_BINARY;
-            }
-            break;
-        case CONTINUOUS:
-            for (i = 0; i < amountOfVariables; i++) {
-                vtype[i] = GRB_CONTINUOUS;
-            }
-            break;
-        case INTEGER:
-            for (i = 0; i < amountOfVariables; i++) {
-                vtype[i] = GRB_INTEGER;
-            }
-            break;
+    double* array = (double*)malloc(len* sizeof(double));
+    if(array == NULL){
+        return NULL;
+    }
+    for(i = 0 ; i < len ; i ++){
+        array[i] = 1.0;
     }
+    return array;
 }
 
+/* SESSION ENVIRONMENT */
+
 /*
- * This function returns the size of the constraint for row: row and value: val.
+ * The Gurobi environment is created once per session, on first use or in the background
+ * by warmGurobiEnvironment, and freed by freeGurobiEnvironment.
+ */
+static GRBenv *sessionEnv = NULL;
+static pthread_t warmThread;
+static int isWarming = 0;
+
+/*
+ * This function creates the session environment.
  * Return values:
- * -1: there is already a cell in row that contains val,
- *     therefore, we don't have to make a constraint for it.
- *  0: None of the cells in this row can contain val,
- *     which means that the board can not be solved.
- * >0: Any number larger than zero that will be returned
- *     from this function, will represent the amount of
- *     cells that can contain val, and the size of the
- *     constraint we would like to build for it.
+ * -1: Gurobi environment allocation failed.
+ *  0: the environment was created.
  */
-int getConstraintRowLength(int val, int row, struct sudokuManager *manager, int *indices){
-    int length = boardLen(manager);
-    int col, count = 0;
-    for(col = 0; col < length; col++){
-        if(indices[threeDIndex(length, row, col, val)] == -1){
-            continue;
-        }
-        if(indices[threeDIndex(length, row, col, val)] == -2){
-            return -1;
-        }
-        count ++;
+int createGurobiEnvironment(){
+    int error;
+
+    /* Create environment - log file is mip1.log */
+    error = GRBloadenv(&sessionEnv, "mip1.log");
+    if (error) {
+        printf("ERROR %d GRBloadenv(): %s\n", error, GRBgeterrormsg(sessionEnv));
+        GRBfreeenv(sessionEnv);
+        sessionEnv = NULL;
+        return -1; /* gurobi error - do not terminate program */
     }
-    return count;
+
+    /* must be set before any model copies the environment */
+    error = GRBsetintparam(sessionEnv, GRB_INT_PAR_LOGTOCONSOLE, 0);
+    if (error) {
+        printf("ERROR %d GRBsetintparam(): %s\n", error, GRBgeterrormsg(sessionEnv));
+        GRBfreeenv(sessionEnv);
+        sessionEnv = NULL;
+        return -1;
+    }
+    return 0;
 }
 
 /*
- * This function builds an array of a constraint of a row by a given length.
+ * This function is run by the warm up thread.
  */
-int *getConstraintRow(int val, int row, struct sudokuManager *manager, int *indices, int constraintLen){
-    int length = boardLen(manager);
-    int col, count = 0;
-    int *constraint;
-    constraint = malloc(constraintLen* sizeof(int));
-    if(constraint == NULL) {
-        return NULL;
+void *warmGurobiThread(void *arg){
+    (void)arg;
+    createGurobiEnvironment();
+    return NULL;
+}
+
+/*
+ * This function starts creating the session environment in the background,
+ * so the first solve does not wait for it.
+ */
+void warmGurobiEnvironment(){
+    if ((sessionEnv != NULL) || isWarming){
+        return;
     }
-    for(col = 0; col < length; col++){
-        if(indices[threeDIndex(length, row, col, val)] == -1){
-            /* none of them can be -2, because we wouldn't
-             * build a constraint in that case */
-            continue;
-        }
-        constraint[count] = indices[threeDIndex(length, row, col, val)];
-        count++;
+    if (pthread_create(&warmThread, NULL, warmGurobiThread, NULL) == 0){
+        isWarming = 1;
+    } /* otherwise, the environment will be created on first use */
+}
+
+/*
+ * This function waits for a background warm up, if one was started.
+ */
+void waitForGurobiWarmUp(){
+    if (isWarming){
+        pthread_join(warmThread, NULL);
+        isWarming = 0;
     }
-    return constraint;
 }
 
 /*
- * This function returns the size of the constraint for column: col and value: val.
+ * This function returns the session environment through *pEnv, creating it if needed.
  * Return values:
- * -1: there is already a cell in col that contains val,
- *     therefore, we don't have to make a constraint for it.
- *  0: None of the cells in this column can contain val,
- *     which means that the board can not be solved.
- * >0: Any number larger than zero that will be returned
- *     from this function, will represent the amount of
- *     cells that can contain val, and the size of the
- *     constraint we would like to build for it.
+ * -1: Gurobi environment allocation failed.
+ *  0: *pEnv is the session environment.
  */
-int getConstraintColLength(int val, int col, struct sudokuManager *manager, int *indices){
-    int length = boardLen(manager);
-    int row, count = 0;
-    for(row = 0; row < length; row++){
-        if(indices[threeDIndex(length, row, col, val)] == -1){
-            continue;
-        }
-        if(indices[threeDIndex(length, row, col, val)] == -2){
-            return -1;
-        }
-        count ++;
+int getGurobiEnvironment(GRBenv **pEnv){
+    waitForGurobiWarmUp();
+    if ((sessionEnv == NULL) && (createGurobiEnvironment() == -1)){
+        return -1;
     }
-    return count;
+    *pEnv = sessionEnv;
+    return 0;
 }
 
+/* PERSISTENT MODEL */
+
 /*
- * This function builds an array of a constraint of a col by a given length.
+ * An ILP or LP model which is kept between solves, and follows the board by incremental changes.
+ * A candidate <row, col, value> gets a variable the first time it is legal, which is never removed:
+ * when the candidate becomes illegal its upper bound is set to 0,
+ * and when its cell holds the value both of its bounds are set to 1.
+ * The constraint of a cell, or of a unit and a value, is added the first time the cell is empty
+ * or the value is missing from the unit. It stays satisfiable after the cell or unit is filled,
+ * since the variable of the value filled is fixed to 1 and all other variables in it are fixed to 0.
+ * The solution of the last optimize is kept until the model changes.
  */
-int *getConstraintCol(int val, int col, struct sudokuManager *manager, int *indices, int constraintLen){
-    int length = boardLen(manager);
-    int row, count = 0;
-    int *constraint;
-    constraint = malloc(constraintLen* sizeof(int));
-    if(constraint == NULL) {
-        return NULL;
-    }
-    for(row = 0; row < length; row++){
-        if(indices[threeDIndex(length, row, col, val)] == -1){
-            /* none of them can be -2, because we wouldn't
-             * build a constraint in that case */
-            continue;
-        }
-        constraint[count] = indices[threeDIndex(length, row, col, val)];
-        count++;
-    }
-    return constraint;
+struct gurobiModel {
+    GRBmodel *model;
+    GurobiOption type;
+    int m;
+    int n;
+    int numVars;
+    int numConstrs;
+    int *varOf; /* N^3: the variable of every candidate, or -1 */
+    char *lb; /* N^3: the bounds every variable has in the model */
+    char *ub;
+    int *constrOf; /* NUM_FAMILIES * N^2: the constraint of every key, or -1 */
+    int *applied; /* N^2: the board the model follows, -1 for a cell never applied */
+    int *unitCount; /* 3 * N^2: how many times every row/column/block of applied holds every value */
+    char *candidateMark; /* N^3: marks the candidates in dirty */
+    int *dirty; /* candidates of which the bounds may have changed */
+    int numDirty;
+    char *keyMark; /* NUM_FAMILIES * N^2: marks the keys in pendingKeys */
+    int *pendingKeys; /* keys of which the constraint may be missing */
+    int numPendingKeys;
+    double *sol; /* N^3: the value of every variable in the last optimize */
+    int solved; /* the result of the last optimize (0 or 1), or -1 if the model changed since */
+    struct candidateIndex index; /* the candidates of the board of the last sync */
+};
+
+/* the models solveBoard and the LP guesses use, built on their first solve */
+static struct gurobiModel ilpModel;
+static struct gurobiModel lpModel;
+/* the scores of the last LP solution of lpModel, by the candidates of lpModel.index */
+static struct lpRelaxation lpResult;
+/* the board lpResult was solved for, which guesses read it from without syncing lpModel */
+static struct relaxationKey lpKey;
+
+/*
+ * This method fills keys with the keys of the NUM_FAMILIES constraints candidate belongs to.
+ */
+void candidateKeys(struct gurobiModel *pm, int candidate, int *keys){
+    int N = pm->m * pm->n, row = candidate / (N * N), col = (candidate / N) % N, v = candidate % N;
+    keys[rowFamily] = familyKey(N, rowFamily, row, v);
+    keys[colFamily] = familyKey(N, colFamily, col, v);
+    keys[blockFamily] = familyKey(N, blockFamily, blockNum(pm->m, pm->n, row, col), v);
+    keys[cellFamily] = familyKey(N, cellFamily, row, col);
 }
 
 /*
- * This function returns the size if the constraint for the block of cell <row, col>.
- * Return values:
- * -1: there is already a cell in the block that contains val,
- *     therefore, we don't have to make a constraint for it.
- *  0: None of the cells in this block can contain val,
- *     which means that the board can not be solved.
- * >0: Any number larger than zero that will be returned
- *     from this function, will represent the amount of
- *     cells that can contain val, and the size of the
- *     constraint we would like to build for it.
+ * This method computes the bounds candidate should have for the applied board.
  */
-int getConstraintBlockLength(int val, int row, int col, struct sudokuManager *manager, int *indices){
-    int m = manager->m, n = manager->n;
-    int count = 0, i, j;
-    int blockRowLowBound, blockRowHighBound, blockColLowBound, blockColHighBound;
-    blockRowLowBound = rowLowBound(m, row);
-    blockRowHighBound = rowHighBound(m, row);
-    blockColLowBound = colLowBound(n, col);
-    blockColHighBound = colHighBound(n, col);
-    /* go through all the cells in the block of cell <row,col> */
-    for(i = blockRowLowBound ; i < blockRowHighBound ; i++){
-        for(j = blockColLowBound ; j < blockColHighBound ; j++) {
-            if(indices[threeDIndex(boardLen(manager), i, j, val)] == -1){
-                continue;
-            }
-            if(indices[threeDIndex(boardLen(manager), i, j, val)] == -2){
-                return -1;
-            }
-            count ++;
-        }
+void candidateBounds(struct gurobiModel *pm, int candidate, char *pLb, char *pUb){
+    int keys[NUM_FAMILIES], N = pm->m * pm->n, val = pm->applied[candidate / N];
+    if (val != 0){ /* the cell is filled */
+        *pLb = (char)(val == (candidate % N) + 1);
+        *pUb = *pLb;
+        return;
     }
-    return count;
+    candidateKeys(pm, candidate, keys);
+    *pLb = 0;
+    *pUb = (char)((pm->unitCount[keys[rowFamily]] == 0) && (pm->unitCount[keys[colFamily]] == 0)
+                  && (pm->unitCount[keys[blockFamily]] == 0));
 }
 
 /*
- * This function builds an array of a constraint of a block by a given length.
+ * This method returns 1 if the constraint of key is needed for the applied board, and 0 otherwise.
  */
-int* getConstraintBlock(int val, int row, int col,
-        struct sudokuManager *manager, int *indices, int constraintLen){
-    int *constraint;
-    int m = manager->m, n = manager->n;
-    int count = 0, i, j, length = boardLen(manager);
-    int blockRowLowBound = rowLowBound(m, row);
-    int blockRowHighBound = rowHighBound(m, row);
-    int blockColLowBound = colLowBound(n, col);
-    int blockColHighBound = colHighBound(n, col);
-
-    constraint = malloc(constraintLen* sizeof(int));
-    if(constraint == NULL) {
-        return NULL;
+int isKeyNeeded(struct gurobiModel *pm, int key){
+    int N = pm->m * pm->n;
+    if (key / (N * N) == cellFamily){
+        return pm->applied[key % (N * N)] == 0;
     }
-    for(i = blockRowLowBound ; i < blockRowHighBound ; i++){
-        for(j = blockColLowBound ; j < blockColHighBound ; j++) {
-            if(indices[threeDIndex(length, i, j, val)] == -1){
-                /* none of them can be -2, because we wouldn't
-                 * build a constraint in that case */
-                continue;
-            }
-            constraint[count] = indices[threeDIndex(length, i, j, val)];
-            count++;
-        }
+    return pm->unitCount[key] == 0;
+}
+
+/*
+ * This function frees a persistent model, and everything related.
+ * The model is built again, of the same type, on its next use.
+ */
+void freeGurobiModel(struct gurobiModel *pm){
+    if (pm->model != NULL){
+        GRBfreemodel(pm->model);
     }
-    return constraint;
+    free(pm->varOf);
+    free(pm->lb);
+    free(pm->ub);
+    free(pm->constrOf);
+    free(pm->applied);
+    free(pm->unitCount);
+    free(pm->candidateMark);
+    free(pm->dirty);
+    free(pm->keyMark);
+    free(pm->pendingKeys);
+    free(pm->sol);
+    freeCandidateIndex(&(pm->index));
+    pm->model = NULL;
+    pm->varOf = pm->constrOf = pm->applied = pm->unitCount = pm->dirty = pm->pendingKeys = NULL;
+    pm->lb = pm->ub = pm->candidateMark = pm->keyMark = NULL;
+    pm->sol = NULL;
+    pm->m = pm->n = 0;
 }
 
 /*
- * This function returns the size of the constraint for cell <row, col>.
+ * This function creates an empty persistent model of the given type for an m*n board, with no cell applied.
+ * An LP model is solved by the dual simplex, which restarts well from the previous basis
+ * after bounds change.
  * Return values:
- * -1: there is already a value in this cell,
- *     therefore, we don't have to make a constraint for it.
- *  0: there is no value set in this cell,
- *     yet all values are illegal- which means that
- *     the board can not be solved.
- * >0: any number larger than zero that will be returned
- *     from this function, will represent the amount of
- *     legal values for this cell, and the size of the
- *     constraint we would like to build for it.
+ * -2: memory allocation failed.
+ * -1: Gurobi had an error.
+ *  0: the model was created.
  */
-int getConstraintCellLength(int row, int col, struct sudokuManager *manager, int *indices){
-    int count = 0, val, length = boardLen(manager);
-    for(val = 0; val < boardLen(manager) ; val++){
-        if(indices[threeDIndex(length, row, col, val)] == -1){
-            continue;
-        }
-        if(indices[threeDIndex(length, row, col, val)] == -2){
+int initGurobiModel(struct gurobiModel *pm, GurobiOption type, int m, int n, GRBenv *env){
+    int i, error, N = m * n, numCandidates = N * N * N, numKeys = NUM_FAMILIES * N * N;
+    pm->type = type;
+    pm->m = m;
+    pm->n = n;
+    pm->numVars = 0;
+    pm->numConstrs = 0;
+    pm->numDirty = 0;
+    pm->numPendingKeys = 0;
+    pm->solved = -1;
+    pm->varOf = (int *)malloc(numCandidates * sizeof(int));
+    pm->lb = (char *)malloc(numCandidates * sizeof(char));
+    pm->ub = (char *)malloc(numCandidates * sizeof(char));
+    pm->constrOf = (int *)malloc(numKeys * sizeof(int));
+    pm->applied = (int *)malloc(N * N * sizeof(int));
+    pm->unitCount = (int *)calloc(3 * N * N, sizeof(int));
+    pm->candidateMark = (char *)calloc(numCandidates, sizeof(char));
+    pm->dirty = (int *)malloc(numCandidates * sizeof(int));
+    pm->keyMark = (char *)calloc(numKeys, sizeof(char));
+    pm->pendingKeys = (int *)malloc(numKeys * sizeof(int));
+    pm->sol = (double *)malloc(numCandidates * sizeof(double));
+    if ((pm->varOf == NULL) || (pm->lb == NULL) || (pm->ub == NULL) || (pm->constrOf == NULL)
+        || (pm->applied == NULL) || (pm->unitCount == NULL) || (pm->candidateMark == NULL)
+        || (pm->dirty == NULL) || (pm->keyMark == NULL) || (pm->pendingKeys == NULL) || (pm->sol == NULL)){
+        freeGurobiModel(pm);
+        return -2;
+    }
+    for (i = 0; i < numCandidates; i++){
+        pm->varOf[i] = -1;
+    }
+    for (i = 0; i < numKeys; i++){
+        pm->constrOf[i] = -1;
+    }
+    for (i = 0; i < N * N; i++){
+        pm->applied[i] = -1;
+    }
+
+    error = GRBnewmodel(env, &(pm->model), "mip1", 0, NULL, NULL, NULL, NULL, NULL);
+    if (error) {
+        printf("ERROR %d GRBnewmodel(): %s\n", error, GRBgeterrormsg(env));
+        freeGurobiModel(pm);
+        return -1;
+    }
+    error = GRBsetintattr(pm->model, GRB_INT_ATTR_MODELSENSE, GRB_MAXIMIZE);
+    if (error) {
+        printf("ERROR %d GRBsetintattr(): %s\n", error, GRBgeterrormsg(env));
+        freeGurobiModel(pm);
+        return -1;
+    }
+    if (pm->type == CONTINUOUS){
+        error = GRBsetintparam(GRBgetenv(pm->model), GRB_INT_PAR_METHOD, 1); /* dual simplex */
+        if (error) {
+            printf("ERROR %d GRBsetintparam(): %s\n", error, GRBgeterrormsg(env));
+            freeGurobiModel(pm);
             return -1;
         }
-        count++;
     }
-    return count;
+    return 0;
 }
 
 /*
- * This function builds an array of a constraint of a cell by a given length.
+ * This method adds candidate to the candidates of which the bounds are checked on this sync.
  */
-int* getConstraintCell(int row, int col, struct sudokuManager *manager, int *indices, int constraintLen){
-    int count = 0, val, length = boardLen(manager);
-    int *constraint;
-    constraint = malloc(constraintLen* sizeof(int));
-    if(constraint == NULL) {
-        return NULL;
+void markCandidate(struct gurobiModel *pm, int candidate){
+    if (!pm->candidateMark[candidate]){
+        pm->candidateMark[candidate] = 1;
+        pm->dirty[pm->numDirty++] = candidate;
     }
-    for(val = 0; val < boardLen(manager); val++){
-        if(indices[threeDIndex(length, row, col, val)] == -1){
-            /* none of them can be -2, because we wouldn't
-             * build a constraint in that case */
-            continue;
+}
+
+/*
+ * This method adds key to the keys of which the constraint is checked on this sync.
+ */
+void markKey(struct gurobiModel *pm, int key){
+    if (!pm->keyMark[key]){
+        pm->keyMark[key] = 1;
+        pm->pendingKeys[pm->numPendingKeys++] = key;
+    }
+}
+
+/*
+ * This method adds or removes value v (0-based) of cell <row, col> from the unit counts of applied,
+ * and marks every candidate of v in the units of the cell.
+ */
+void updateUnitsOfValue(struct gurobiModel *pm, int row, int col, int v, int diff){
+    int f, k, keys[NUM_FAMILIES], N = pm->m * pm->n;
+    candidateKeys(pm, threeDIndex(N, row, col, v), keys);
+    for (f = rowFamily; f <= blockFamily; f++){
+        pm->unitCount[keys[f]] += diff;
+        if (diff < 0){ /* v may be missing from this unit now */
+            markKey(pm, keys[f]);
+        }
+        for (k = 0; k < N; k++){
+            markCandidate(pm, keyCandidate(pm->m, pm->n, keys[f], k));
         }
-        constraint[count] = indices[threeDIndex(length, row, col, val)];
-        count++;
     }
-    return constraint;
 }
 
 /*
- * This function creates an array and fills it with double ones.
+ * This method applies value val to cell <row, col> of the model's board, and marks everything it affects.
  */
-double* onesArray(int len){
-    int i;
-    double* array = (double*)malloc(len* sizeof(double));
-    if(array == NULL){
-        return NULL;
+void applyCellToModel(struct gurobiModel *pm, int row, int col, int val){
+    int k, N = pm->m * pm->n, old = pm->applied[row * N + col];
+    pm->applied[row * N + col] = val;
+    if (old > 0){
+        updateUnitsOfValue(pm, row, col, old - 1, -1);
     }
-    for(i = 0 ; i < len ; i ++){
-        array[i] = 1.0;
+    if (val > 0){
+        updateUnitsOfValue(pm, row, col, val - 1, 1);
+    }
+    else{
+        markKey(pm, familyKey(N, cellFamily, row, col));
+    }
+    for (k = 0; k < N; k++){
+        markCandidate(pm, threeDIndex(N, row, col, k));
     }
-    return array;
 }
 
 /*
- * This method frees Gurobi model and environment, and everything related.
+ * This function adds a variable for every candidate in candidates,
+ * with a coefficient in every constraint it belongs to that already exists.
+ * Return values:
+ * -2: memory allocation failed.
+ * -1: Gurobi had an error.
+ *  0: the variables were added.
  */
-void freeGurobi(double *obj, char *vtype, GRBenv *env, GRBmodel *model) {
-    free(obj);
+int addModelVariables(struct gurobiModel *pm, int *candidates, int count){
+    int i, f, nnz = 0, error, keys[NUM_FAMILIES];
+    int *vbeg, *vind, N = pm->m * pm->n;
+    double *vval, *lb, *ub, *obj;
+    char *vtype;
+    if (count == 0){
+        return 0;
+    }
+    vbeg = (int *)malloc(count * sizeof(int));
+    vind = (int *)malloc(NUM_FAMILIES * count * sizeof(int));
+    vval = onesArray(NUM_FAMILIES * count);
+    lb = (double *)malloc(count * sizeof(double));
+    ub = (double *)malloc(count * sizeof(double));
+    vtype = (char *)malloc(count * sizeof(char));
+    obj = (double *)malloc(count * sizeof(double));
+    if ((vbeg == NULL) || (vind == NULL) || (vval == NULL) || (lb == NULL) || (ub == NULL) || (vtype == NULL)
+        || (obj == NULL)){
+        free(vbeg);
+        free(vind);
+        free(vval);
+        free(lb);
+        free(ub);
+        free(vtype);
+        free(obj);
+        return -2;
+    }
+    for (i = 0; i < count; i++){
+        vbeg[i] = nnz;
+        candidateKeys(pm, candidates[i], keys);
+        for (f = 0; f < NUM_FAMILIES; f++){
+            if (pm->constrOf[keys[f]] != -1){
+                vind[nnz++] = pm->constrOf[keys[f]];
+            }
+        }
+        candidateBounds(pm, candidates[i], &(pm->lb[pm->numVars + i]), &(pm->ub[pm->numVars + i]));
+        lb[i] = pm->lb[pm->numVars + i];
+        ub[i] = pm->ub[pm->numVars + i];
+        vtype[i] = (pm->type == CONTINUOUS) ? GRB_CONTINUOUS : GRB_BINARY;
+        /* the ILP objective is randomized on every solve, the LP one stays fixed so the basis stays useful */
+        obj[i] = (pm->type == CONTINUOUS) ? randRangeDouble(1.0, (double)3*N) : 0;
+    }
+    error = GRBaddvars(pm->model, count, nnz, vbeg, vind, vval, obj, lb, ub, vtype, NULL);
+    free(vbeg);
+    free(vind);
+    free(vval);
+    free(lb);
+    free(ub);
     free(vtype);
-    if (model != NULL){
-        GRBfreemodel(model);
+    free(obj);
+    if (!error){
+        error = GRBupdatemodel(pm->model);
+    }
+    if (error) {
+        printf("ERROR %d GRBaddvars(): %s\n", error, GRBgeterrormsg(GRBgetenv(pm->model)));
+        return -1;
     }
-    if (env != NULL){
-        GRBfreeenv(env);
+    for (i = 0; i < count; i++){
+        pm->varOf[candidates[i]] = pm->numVars++;
     }
+    return 0;
 }
 
 /*
- * This function sets constraints for each row of the sudoku board.
- *  Return values:
+ * This function adds the constraint of every key in keys, which contains every variable of the key.
+ * If the variables of the model are exactly the candidates in index, the members of every constraint are
+ * read from index. Otherwise, index == NULL and they are searched among all the candidates of the key.
+ * Return values:
  * -2: memory allocation failed.
  * -1: Gurobi had an error.
- *  0: the board is invalid.
- *  1: finishing building the constraints successfully.
+ *  0: the constraints were added.
  */
-int setRowConstraints(struct sudokuManager *manager, int N, int *indices, GRBmodel *model, GRBenv *env){
-    int i, k, constraintLength, error, *ind;
-    double *val;
-
-    for(i = 0; i < N ; i++){
-        for(k = 0; k < N ; k++){
-            constraintLength = getConstraintRowLength(k, i, manager, indices);
-            if(constraintLength == -1){
-                /* k is setted somewhere in the row */
-                continue;
-            }
-            if(constraintLength == 0){
-                /* k is illegal for all cells in that row,
-                 * the board is invalid */
-                return 0;
-            }
-            ind = getConstraintRow(k, i, manager, indices, constraintLength);
-            if(ind == NULL){
-                return -2;
+int addModelConstraints(struct gurobiModel *pm, int *keys, int count, struct candidateIndex *index){
+    int i, k, var, nnz = 0, error, N = pm->m * pm->n;
+    int *cbeg, *cind, *members, numMembers, unit, v;
+    double *cval, *rhs;
+    char *sense;
+    if (count == 0){
+        return 0;
+    }
+    cbeg = (int *)malloc(count * sizeof(int));
+    cind = (int *)malloc(N * count * sizeof(int));
+    cval = onesArray(N * count);
+    rhs = onesArray(count);
+    sense = (char *)malloc(count * sizeof(char));
+    if ((cbeg == NULL) || (cind == NULL) || (cval == NULL) || (rhs == NULL) || (sense == NULL)){
+        free(cbeg);
+        free(cind);
+        free(cval);
+        free(rhs);
+        free(sense);
+        return -2;
+    }
+    for (i = 0; i < count; i++){
+        cbeg[i] = nnz;
+        sense[i] = GRB_EQUAL;
+        if (index == NULL){
+            for (k = 0; k < N; k++){
+                var = pm->varOf[keyCandidate(pm->m, pm->n, keys[i], k)];
+                if (var != -1){
+                    cind[nnz++] = var;
+                }
             }
-            val = onesArray(constraintLength);
-            if (val == NULL){
-                free(ind);
-                return -2;
+            continue;
+        }
+        unit = (keys[i] / N) % N;
+        v = keys[i] % N;
+        if (keys[i] / (N * N) == cellFamily){ /* unit is the row and v is the column */
+            members = cellCandidates(index, unit, v, &numMembers);
+            for (k = 0; k < numMembers; k++){
+                cind[nnz++] = pm->varOf[threeDIndex(N, unit, v, members[k])];
             }
-            error = GRBaddconstr(model, constraintLength, ind, val, GRB_EQUAL, 1, NULL);
-            free(ind);
-            free(val);
-            if (error) {
-                printf("ERROR %d 1st GRBaddconstr(): %s\n", error, GRBgeterrormsg(env));
-                return -1;
+        }
+        else{
+            members = unitCandidates(index, (enum unitType)(keys[i] / (N * N)), unit, v, &numMembers);
+            for (k = 0; k < numMembers; k++){
+                cind[nnz++] = pm->varOf[members[k] * N + v];
             }
         }
     }
-    return 1;
+    error = GRBaddconstrs(pm->model, count, nnz, cbeg, cind, cval, sense, rhs, NULL);
+    free(cbeg);
+    free(cind);
+    free(cval);
+    free(rhs);
+    free(sense);
+    if (!error){
+        error = GRBupdatemodel(pm->model);
+    }
+    if (error) {
+        printf("ERROR %d GRBaddconstrs(): %s\n", error, GRBgeterrormsg(GRBgetenv(pm->model)));
+        return -1;
+    }
+    for (i = 0; i < count; i++){
+        pm->constrOf[keys[i]] = pm->numConstrs++;
+    }
+    return 0;
 }
 
 /*
- * This function sets constraints for each column of the sudoku board.
+ * This function sets the bounds of every variable in vars to the bounds in pm->lb and pm->ub.
  * Return values:
  * -2: memory allocation failed.
  * -1: Gurobi had an error.
- *  0: the board is invalid.
- *  1: finishing building the constraints successfully.
+ *  0: the bounds were set.
  */
-int setColConstraints(struct sudokuManager *manager, int N, int *indices, GRBmodel *model, GRBenv *env){
-    int j, k, constraintLength, error, *ind;
-    double *val;
-
-    for(j = 0; j < N ; j++){
-        for(k = 0; k < N ; k++){
-            constraintLength = getConstraintColLength(k, j, manager, indices);
-            if(constraintLength == -1){
-                /* k is setted somewhere in the col */
-                continue;
-            }
-            if(constraintLength == 0){
-                /* k is illegal for all cells in that col, the board is invalid */
-                return 0;
-            }
-            ind = getConstraintCol(k, j, manager, indices, constraintLength);
-            if(ind == NULL){
-
-                return -2;
-            }
-            val = onesArray(constraintLength);
-            if (val == NULL){
-                free(ind);
-                return -2;
-            }
-            error = GRBaddconstr(model, constraintLength, ind, val, GRB_EQUAL, 1, NULL);
-            free(ind);
-            free(val);
-            if (error) {
-                printf("ERROR %d 1st GRBaddconstr(): %s\n", error, GRBgeterrormsg(env));
-                return -1;
-            }
+int setModelBounds(struct gurobiModel *pm, int *vars, int count){
+    int i, error;
+    double *values;
+    if (count == 0){
+        return 0;
+    }
+    values = (double *)malloc(count * sizeof(double));
+    if (values == NULL){
+        return -2;
+    }
+    for (i = 0; i < count; i++){
+        values[i] = pm->lb[vars[i]];
+    }
+    error = GRBsetdblattrlist(pm->model, GRB_DBL_ATTR_LB, count, vars, values);
+    if (!error){
+        for (i = 0; i < count; i++){
+            values[i] = pm->ub[vars[i]];
         }
+        error = GRBsetdblattrlist(pm->model, GRB_DBL_ATTR_UB, count, vars, values);
     }
-    return 1;
+    free(values);
+    if (error) {
+        printf("ERROR %d GRBsetdblattrlist(): %s\n", error, GRBgeterrormsg(GRBgetenv(pm->model)));
+        return -1;
+    }
+    return 0;
 }
 
 /*
- * This function sets constraints for each cell of the sudoku board.
+ * This function brings the checked candidates and keys of a sync into the model:
+ * it adds the variables and constraints which are missing, and sets the bounds which changed.
  * Return values:
  * -2: memory allocation failed.
  * -1: Gurobi had an error.
- *  0: the board is invalid.
- *  1: finishing building the constraints successfully.
+ *  0: the model follows the applied board.
  */
-int setCellsConstraints(struct sudokuManager *manager, int N, int *indices, GRBmodel *model, GRBenv *env){
-    int i, j, constraintLength, error, *ind;
-    double *val;
-
-    for(i = 0; i < N ; i++){
-        for(j = 0; j < N ; j++){
-            constraintLength = getConstraintCellLength(i, j, manager, indices);
-            if(constraintLength == -1){
-                /* there is a value in cell <i,j> already */
-                continue;
-            }
-            if(constraintLength == 0){
-                /* all values for cell <i,j> are illegal, the board is invalid */
-                return 0;
-            }
-            ind = getConstraintCell(i, j, manager, indices, constraintLength);
-            if(ind == NULL){
-                return -2;
-            }
-            val = onesArray(constraintLength);
-            if (val == NULL){
-                free(ind);
-                return -2;
-            }
-            /* add constraint to model */
-            error = GRBaddconstr(model, constraintLength, ind, val, GRB_EQUAL, 1, NULL);
-            free(ind);
-            free(val);
-            if (error) {
-                printf("ERROR %d 1st GRBaddconstr(): %s\n", error, GRBgeterrormsg(env));
-                return -1;
+int commitModelChanges(struct gurobiModel *pm){
+    int i, var, res, numNew = 0, numChanged = 0, numKeys = 0;
+    int *newCandidates, *changedVars;
+    char lb, ub;
+
+    newCandidates = (int *)malloc((pm->numDirty + 1) * sizeof(int));
+    changedVars = (int *)malloc((pm->numDirty + 1) * sizeof(int));
+    if ((newCandidates == NULL) || (changedVars == NULL)){
+        free(newCandidates);
+        free(changedVars);
+        return -2;
+    }
+    for (i = 0; i < pm->numDirty; i++){
+        candidateBounds(pm, pm->dirty[i], &lb, &ub);
+        var = pm->varOf[pm->dirty[i]];
+        if (var == -1){
+            if (ub){ /* the candidate is legal for the first time */
+                newCandidates[numNew++] = pm->dirty[i];
             }
         }
+        else if ((pm->lb[var] != lb) || (pm->ub[var] != ub)){
+            pm->lb[var] = lb;
+            pm->ub[var] = ub;
+            changedVars[numChanged++] = var;
+        }
     }
-    return 1;
+    for (i = 0; i < pm->numPendingKeys; i++){ /* keeps only the keys of which the constraint is missing */
+        if ((pm->constrOf[pm->pendingKeys[i]] == -1) && isKeyNeeded(pm, pm->pendingKeys[i])){
+            pm->pendingKeys[numKeys++] = pm->pendingKeys[i];
+        }
+    }
+
+    /* variables go first, so the new constraints contain them */
+    res = addModelVariables(pm, newCandidates, numNew);
+    if (!res){
+        res = addModelConstraints(pm, pm->pendingKeys, numKeys, NULL);
+    }
+    if (!res){
+        res = setModelBounds(pm, changedVars, numChanged);
+    }
+    if (numNew || numKeys || numChanged){ /* the last solution may not hold anymore */
+        pm->solved = -1;
+    }
+    free(newCandidates);
+    free(changedVars);
+    return res;
 }
 
 /*
- * This function sets constraints for each block of the sudoku board.
+ * This function fills an empty persistent model from pm->index, the candidate index of the board
+ * seen through view: a variable for every candidate and a constraint for every empty cell and every
+ * unit and value missing from it. It costs as much as the open candidates.
  * Return values:
  * -2: memory allocation failed.
  * -1: Gurobi had an error.
- *  0: the board is invalid.
- *  1: finishing building the constraints successfully.
+ *  0: the model follows the board.
  */
-int setBlocksConstraints(struct sudokuManager *manager, int N, int *indices, GRBmodel *model, GRBenv *env){
-    int i, j, k , b, constraintLength, error, *ind;
-    double *val;
-
-    for(b = 0; b < N ; b++){ /* b = #block */
-        for(k = 0; k < N ; k++){ /* k = value */
-            getFirstIndexInBlock(manager->m, manager->n, b, &i, &j);
-            constraintLength = getConstraintBlockLength(k, i, j, manager, indices);
-            if(constraintLength == -1){
-                /* value k is already in the block */
-                continue;
-            }
-            if(constraintLength == 0){
-                /* value k is illegal for all cells in the block, the board is invalid */
-                return 0;
-            }
-            ind = getConstraintBlock(k, i, j, manager, indices, constraintLength);
-            if(ind == NULL){
-                return -2;
-            }
-            val = onesArray(constraintLength);
-            if (val == NULL){
-                free(ind);
-                return -2;
+int buildGurobiModel(struct gurobiModel *pm, struct boardView *view){
+    int row, col, k, f, res, count, numValues, *values, numKeys = 0, N = viewLen(view);
+    int keys[NUM_FAMILIES], *candidates;
+
+    candidates = (int *)malloc((pm->index.numCandidates + 1) * sizeof(int));
+    if (candidates == NULL){
+        return -2;
+    }
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            pm->applied[row * N + col] = viewCell(view, row, col);
+            if (viewCell(view, row, col) != 0){
+                candidateKeys(pm, threeDIndex(N, row, col, viewCell(view, row, col) - 1), keys);
+                for (f = rowFamily; f <= blockFamily; f++){
+                    pm->unitCount[keys[f]]++;
+                }
             }
-            /* add constraint to model */
-            error = GRBaddconstr(model, constraintLength, ind, val, GRB_EQUAL, 1, NULL);
-            free(ind);
-            free(val);
-            if (error) {
-                printf("ERROR %d 1st GRBaddconstr(): %s\n", error, GRBgeterrormsg(env));
-                return -1;
+        }
+    }
+    count = 0;
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            values = cellCandidates(&(pm->index), row, col, &numValues);
+            for (k = 0; k < numValues; k++){
+                candidates[count++] = threeDIndex(N, row, col, values[k]);
             }
         }
     }
-    return 1;
+    res = addModelVariables(pm, candidates, count);
+    free(candidates);
+    if (res){
+        return res;
+    }
+
+    for (k = 0; k < NUM_FAMILIES * N * N; k++){
+        if (isKeyNeeded(pm, k)){
+            pm->pendingKeys[numKeys++] = k;
+        }
+    }
+    return addModelConstraints(pm, pm->pendingKeys, numKeys, &(pm->index));
 }
 
 /*
- * This function sets constraints for each variable to be non-negative.
+ * This function brings a persistent model of the given type to follow the board seen through view,
+ * and keeps the candidate index of the board in pm->index.
+ * Only the cells which changed since the last sync are applied, unless the model
+ * is missing, was built for another geometry, or most of the board changed; in these cases
+ * it is built again. The time spent on the index and on the model is added to call.
  * Return values:
+ * -2: memory allocation failed.
  * -1: Gurobi had an error.
- *  0: finishing building the constraints successfully.
+ *  0: the model follows the board.
  */
-int setNonnegativityConstraints(int N, int *indices, GRBmodel *model, GRBenv *env){
-    int i, j, k, error;
-    int staticInd[1];
-    double staticVal[1];
-
-    for(i = 0; i < N; i ++){
-        for(j = 0; j < N; j ++){
-            for(k = 0; k < N; k ++ ){
-                if((indices[threeDIndex(N, i, j, k)] == -1)||(indices[threeDIndex(N, i, j, k)] == -2)){
-                    continue;
-                }
-                staticInd[0] = indices[threeDIndex(N, i, j, k)];
-                staticVal[0] = 1;
-                error = GRBaddconstr(model, 1, staticInd, staticVal, GRB_GREATER_EQUAL, 0, NULL);
-                if (error) {
-                    printf("ERROR %d 1st GRBaddconstr(): %s\n", error, GRBgeterrormsg(env));
-                    return -1;
-                }
+int syncGurobiModel(struct gurobiModel *pm, GurobiOption type, struct boardView *view, struct solverCall *call){
+    int row, col, i, res, isNew = 0, changes = 0, N = viewLen(view);
+    double since = monotonicSeconds();
+    GRBenv *env;
+
+    if ((pm->model != NULL) && (pm->m == view->m) && (pm->n == view->n)){
+        for (row = 0; row < N; row++){
+            for (col = 0; col < N; col++){
+                changes += (pm->applied[row * N + col] != viewCell(view, row, col));
             }
         }
     }
-    return 0;
+    if ((pm->model == NULL) || (pm->m != view->m) || (pm->n != view->n) || (changes > (N * N) / 2)){
+        freeGurobiModel(pm);
+        if (getGurobiEnvironment(&env) == -1){
+            return -1;
+        }
+        res = initGurobiModel(pm, type, view->m, view->n, env);
+        if (res){
+            return res;
+        }
+        isNew = 1;
+    }
+    endSolverPhase(call, modelPhase, since);
+    since = monotonicSeconds();
+    freeCandidateIndex(&(pm->index));
+    if (initCandidateIndex(&(pm->index), view) == -1){
+        freeGurobiModel(pm);
+        return -2;
+    }
+    endSolverPhase(call, indexPhase, since);
+    since = monotonicSeconds();
+    if (isNew){
+        res = buildGurobiModel(pm, view);
+        if (res){
+            freeGurobiModel(pm);
+        }
+        endSolverPhase(call, modelPhase, since);
+        return res;
+    }
+
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            if (pm->applied[row * N + col] != viewCell(view, row, col)){
+                applyCellToModel(pm, row, col, viewCell(view, row, col));
+            }
+        }
+    }
+    res = commitModelChanges(pm);
+    for (i = 0; i < pm->numDirty; i++){
+        pm->candidateMark[pm->dirty[i]] = 0;
+    }
+    for (i = 0; i < NUM_FAMILIES * N * N; i++){
+        pm->keyMark[i] = 0;
+    }
+    pm->numDirty = 0;
+    pm->numPendingKeys = 0;
+    if (res){ /* the model is left half updated */
+        freeGurobiModel(pm);
+    }
+    endSolverPhase(call, modelPhase, since);
+    return res;
 }
 
 /*
- * This method allocates all memory needed for Gurobi's operation.
- * If other allocations fail, it returns -2.
- * Otherwise, it returns 0.
- *  Return values:
- * -2: memory allocation failed.
- * -1: Gurobi environment or model allocation failed.
- *  0: initialized with no errors.
+ * This function frees the session's model and environment.
  */
-int initGurobi(GRBenv **pEnv, GRBmodel **pModel,
-               double **pObj, char **pVtype, int amountOfVariables){
-    int error = 0;
+void freeGurobiEnvironment(){
+    freeGurobiModel(&ilpModel);
+    freeGurobiModel(&lpModel);
+    free(lpResult.scores);
+    lpResult.scores = NULL;
+    freeRelaxationKey(&lpKey);
+    waitForGurobiWarmUp();
+    if (sessionEnv != NULL){
+        GRBfreeenv(sessionEnv);
+        sessionEnv = NULL;
+    }
+}
 
-    /* Create environment - log file is mip1.log */
-    error = GRBloadenv(pEnv, "mip1.log");
-    if (error) {
-        printf("ERROR %d GRBloadenv(): %s\n", error, GRBgeterrormsg(*pEnv));
-        freeGurobi(*pObj, *pVtype, *pEnv, *pModel);
-        return -1; /* gurobi error - do not terminate program */
+/*
+ * This function is the callback of a solve that may be stopped by another thread.
+ * Gurobi calls it periodically while it optimizes, and it asks Gurobi to stop once *usrdata is set.
+ */
+int __stdcall stopCallback(GRBmodel *model, void *cbdata, int where, void *usrdata){
+    (void)cbdata;
+    (void)where;
+    if (*(volatile int *)usrdata){
+        GRBterminate(model);
     }
+    return 0;
+}
 
-    /* Create an empty model named "mip1" */
-    error = GRBnewmodel(*pEnv, pModel, "mip1", 0, NULL, NULL, NULL, NULL, NULL);
+/*
+ * This function limits the next optimize of a persistent model to what is left of the budget of the command.
+ * Return values:
+ * -4: the budget already ran out.
+ * -1: Gurobi had an error.
+ *  0: the limits were set.
+ */
+int limitGurobiModel(struct gurobiModel *pm){
+    int error = 0, kind;
+    double left;
+    static const char *params[NUM_BUDGET_KINDS] = {GRB_DBL_PAR_TIMELIMIT, GRB_DBL_PAR_NODELIMIT,
+                                                   GRB_DBL_PAR_ITERATIONLIMIT};
+    for (kind = 0; (kind < NUM_BUDGET_KINDS) && !error; kind++){
+        left = budgetLeft((enum budgetKind)kind);
+        if (left == 0){
+            return -4;
+        }
+        error = GRBsetdblparam(GRBgetenv(pm->model), params[kind], (left == -1) ? GRB_INFINITY : left);
+    }
     if (error) {
-        printf("ERROR %d GRBnewmodel(): %s\n", error, GRBgeterrormsg(*pEnv));
-        freeGurobi(*pObj, *pVtype, *pEnv, *pModel);
+        printf("ERROR %d GRBsetdblparam(): %s\n", error, GRBgeterrormsg(GRBgetenv(pm->model)));
         return -1;
     }
+    return 0;
+}
 
-    *pObj = malloc(amountOfVariables * sizeof(double));
-    if(*pObj == NULL){
-        freeGurobi(*pObj, *pVtype, *pEnv, *pModel);
-        return -2;
+/*
+ * This function charges the iterations, and for an ILP the nodes, of the last optimize of a persistent model
+ * to the budget of the command. The work is only counted, so a failure to read it is ignored.
+ */
+void chargeGurobiModel(struct gurobiModel *pm){
+    double count;
+    if (!GRBgetdblattr(pm->model, GRB_DBL_ATTR_ITERCOUNT, &count)){
+        chargeBudget(iterationBudget, count);
     }
-
-    *pVtype = malloc(amountOfVariables * sizeof(char));
-    if(*pVtype == NULL){
-        freeGurobi(*pObj, *pVtype, *pEnv, *pModel);
-        return -2;
+    if ((pm->type != CONTINUOUS) && !GRBgetdblattr(pm->model, GRB_DBL_ATTR_NODECOUNT, &count)){
+        chargeBudget(nodeBudget, count);
     }
+}
 
-    return 0;
+/*
+ * This function writes a persistent model to the file set by setModelExport, if there is one.
+ * The export is only for debugging, so a failure to write it is printed and ignored.
+ */
+void exportGurobiModel(struct gurobiModel *pm){
+    int error;
+    if (modelExportPath() == NULL){
+        return;
+    }
+    error = GRBupdatemodel(pm->model);
+    if (!error){
+        error = GRBwrite(pm->model, modelExportPath());
+    }
+    if (error) {
+        printf("ERROR %d GRBwrite(): %s\n", error, GRBgeterrormsg(GRBgetenv(pm->model)));
+    }
 }
 
 /*
- * This method solves manager using ILP or LP depending on type.
- * type == BINARY ---> *retBoard is the solution for the board if exists,
- * and if there is no solution, *retBoard == NULL.
- * type == CONTINUOUS ---> user must use with *retBoard == NULL.
+ * This function optimizes a persistent model within the budget of the command, and keeps the result
+ * in pm->solved and the solution in pm->sol.
  * Return values:
- * -2: memory allocation failed.
+ * -4: the budget of the command ran out.
+ * -3: the optimize was stopped through stopCallback.
  * -1: Gurobi had an error.
- *  0: optimal solution could not be found.
- *  1: optimal solution has been found.
+ *  0: the board is invalid.
+ *  1: an optimal solution was found.
  */
-int solveGurobi(struct sudokuManager *manager, GurobiOption type, int **retBoard,
-                double *sol, int *indices, int amountOfVariables){
-    int i, j, k, index, res;
-    int N = boardLen(manager);
-    GRBenv    *env   = NULL;
-    GRBmodel  *model = NULL;
-    int       error  = 0;
-    double    *obj = NULL; /* V */
-    char      *vtype = NULL; /* V */
-    int       optimstatus;
-    double    objval; /* */
-    int       currIndex;
-
-    res = initGurobi(&env, &model, &obj, &vtype, amountOfVariables);
-    if (res){
-        return res;
+int optimizeGurobiModel(struct gurobiModel *pm){
+    int error, optimstatus;
+
+    error = limitGurobiModel(pm);
+    if (error){
+        return error;
     }
-    /* everything is allocated */
 
-    error = GRBsetintparam(env, GRB_INT_PAR_LOGTOCONSOLE, 0);
+    /* Optimize model */
+    error = GRBoptimize(pm->model);
+    chargeGurobiModel(pm);
     if (error) {
-        printf("ERROR %d GRBsetintparam(): %s\n", error, GRBgeterrormsg(env));
-        freeGurobi(obj, vtype, env, model);
+        printf("ERROR %d GRBoptimize(): %s\n", error, GRBgeterrormsg(GRBgetenv(pm->model)));
         return -1;
     }
 
-    srand (time(NULL));
-    /* randomizes coefficients for objective function */
-    for (i = 0; i < amountOfVariables; i++) {
-        obj[i] = randRangeDouble(1.0, (double)3*N);
-    }
-
-    /* variable types - for objective function */
-    initVariableType(type, vtype, amountOfVariables);
-
-    /* add variables to model */
-    error = GRBaddvars(model, amountOfVariables, 0, NULL, NULL, NULL, obj, NULL, NULL, vtype, NULL);
+    /* Get solution information */
+    error = GRBgetintattr(pm->model, GRB_INT_ATTR_STATUS, &optimstatus);
     if (error) {
-        printf("ERROR %d GRBaddvars(): %s\n", error, GRBgeterrormsg(env));
-        freeGurobi(obj, vtype, env, model);
+        printf("ERROR %d GRBgetintattr(): %s\n", error, GRBgeterrormsg(GRBgetenv(pm->model)));
         return -1;
     }
+    if (optimstatus != GRB_OPTIMAL){
+        /* a fixed variable may make the model infeasible, rather than a missing candidate */
+        if ((optimstatus == GRB_INF_OR_UNBD) || (optimstatus == GRB_INFEASIBLE)){
+            pm->solved = 0;
+            return 0;
+        }
+        if (optimstatus == GRB_INTERRUPTED){
+            return -3;
+        }
+        if ((optimstatus == GRB_TIME_LIMIT) || (optimstatus == GRB_NODE_LIMIT)
+            || (optimstatus == GRB_ITERATION_LIMIT)){
+            return -4;
+        }
+        return -1; /* error or calculation stopped */
+    }
 
-    error = GRBsetintattr(model, GRB_INT_ATTR_MODELSENSE, GRB_MAXIMIZE);
+    /* get the solution - the assignment to each variable */
+    error = GRBgetdblattrarray(pm->model, GRB_DBL_ATTR_X, 0, pm->numVars, pm->sol);
     if (error) {
-        printf("ERROR %d GRBsetintattr(): %s\n", error, GRBgeterrormsg(env));
-        freeGurobi(obj, vtype, env, model);
+        printf("ERROR %d GRBgetdblattrarray(): %s\n", error, GRBgeterrormsg(GRBgetenv(pm->model)));
         return -1;
     }
+    pm->solved = 1;
+    return 1;
+}
 
-    /* update the model - to integrate new variables */
-    error = GRBupdatemodel(model);
+/*
+ * This function gives the ILP model a random objective, so every solve may find another solution.
+ * Return values:
+ * -2: memory allocation failed.
+ * -1: Gurobi had an error.
+ *  0: the objective was set.
+ */
+int randomizeILPObjective(int N){
+    int i, error;
+    double *obj = (double *)malloc((ilpModel.numVars + 1) * sizeof(double));
+    if (obj == NULL){
+        return -2;
+    }
+    /* randomizes coefficients for objective function */
+    for (i = 0; i < ilpModel.numVars; i++) {
+        obj[i] = randRangeDouble(1.0, (double)3*N);
+    }
+    error = GRBsetdblattrarray(ilpModel.model, GRB_DBL_ATTR_OBJ, 0, ilpModel.numVars, obj);
+    free(obj);
     if (error) {
-        printf("ERROR %d GRBupdatemodel(): %s\n", error, GRBgeterrormsg(env));
-        freeGurobi(obj, vtype, env, model);
+        printf("ERROR %d GRBsetdblattrarray(): %s\n", error, GRBgeterrormsg(GRBgetenv(ilpModel.model)));
         return -1;
     }
+    return 0;
+}
 
-    /* ROWS */
-    res = setRowConstraints(manager, N, indices, model, env);
-    if (res != 1){ /* if it equals 1, constraints setting went successfully */
-        freeGurobi(obj, vtype, env, model);
-        return res;
+/*
+ * This function fills retBoard with the board seen through view, completed by sol,
+ * an assignment to the variables of the ILP model.
+ */
+void decodeILPSolution(struct boardView *view, double *sol, int *retBoard){
+    int i, j, k, count, *values, N = viewLen(view);
+    for(i = 0; i < N; i++){
+        for(j = 0; j < N; j++){
+            retBoard[matIndex(view->m, view->n, i, j)] = viewCell(view, i, j);
+            values = cellCandidates(&(ilpModel.index), i, j, &count); /* none if the cell is filled */
+            for (k = 0; k < count; k++) {
+                if(sol[ilpModel.varOf[threeDIndex(N, i, j, values[k])]] > 0.5){
+                    retBoard[matIndex(view->m, view->n, i, j)] = values[k] + 1;
+                    break;
+                }
+            }
+        }
     }
+}
 
-    /* COLS */
-    res = setColConstraints(manager, N, indices, model, env);
-    if (res != 1){ /* if it equals 1, constraints setting went successfully */
-        freeGurobi(obj, vtype, env, model);
-        return res;
-    }
+/*
+ * This method solves the current board using ILP, like solveBoardUntil,
+ * and adds the time it spent in every phase to call.
+ */
+int solveILP(struct boardView *view, int *retBoard, volatile int *stop, struct solverCall *call){
+    int res, error;
+    double since;
 
-    /* CELLS */
-    res = setCellsConstraints(manager, N, indices, model, env);
-    if (res != 1){ /* if it equals 1, constraints setting went successfully */
-        freeGurobi(obj, vtype, env, model);
+    res = syncGurobiModel(&ilpModel, BINARY, view, call);
+    if (res){
         return res;
     }
+    if ((stop != NULL) && *stop){ /* no need to start optimizing */
+        return -3;
+    }
 
-    /* BLOCKS - MUST ADD we only need one constraint per block for each value */
-    res = setBlocksConstraints(manager, N, indices, model, env);
-    if (res != 1){ /* if it equals 1, constraints setting went successfully */
-        freeGurobi(obj, vtype, env, model);
+    since = monotonicSeconds();
+    res = randomizeILPObjective(viewLen(view));
+    if (res){
         return res;
     }
 
-    /* MAKE SURE EVERY VARIABLE >=0 */
-    if(type == CONTINUOUS){
-        res = setNonnegativityConstraints(N, indices, model, env);
-        if (res){
-            freeGurobi(obj, vtype, env, model);
-            return res;
+    if (stop != NULL){
+        error = GRBsetcallbackfunc(ilpModel.model, stopCallback, (void *)stop);
+        if (error) {
+            printf("ERROR %d GRBsetcallbackfunc(): %s\n", error, GRBgeterrormsg(GRBgetenv(ilpModel.model)));
+            return -1;
         }
     }
+    endSolverPhase(call, modelPhase, since);
+    exportGurobiModel(&ilpModel);
+    since = monotonicSeconds();
+    res = optimizeGurobiModel(&ilpModel);
+    endSolverPhase(call, optimizePhase, since);
+    if (stop != NULL){
+        GRBsetcallbackfunc(ilpModel.model, NULL, NULL);
+    }
+    if ((res != 1) || (retBoard == NULL)){
+        return res;
+    }
+    since = monotonicSeconds();
+    decodeILPSolution(view, ilpModel.sol, retBoard);
+    endSolverPhase(call, decodePhase, since);
+    return 1;
+}
 
-    /* Optimize model */
-    error = GRBoptimize(model);
+/*
+ * This method solves the current board using ILP, like solveBoard,
+ * but gives up once *stop is set by another thread (unless stop == NULL).
+ * The call is recorded in the solver statistics.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -3: the solve was stopped.
+ * -2: memory allocation failed.
+ * -1: Gurobi had an error.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoard is filled with a solution.
+ */
+int solveBoardUntil(struct boardView *view, int *retBoard, volatile int *stop){
+    struct solverCall call;
+    int res;
+    startSolverCall(&call, ilpSolver, view->m, view->n);
+    res = solveILP(view, retBoard, stop, &call);
+    call.numVars = ilpModel.numVars;
+    call.numConstrs = ilpModel.numConstrs;
+    recordSolverCall(&call, res);
+    return res;
+}
+
+/*
+ * This function sets the pool of solutions the ILP model keeps, in search mode mode (0 for the solutions
+ * found on the way to the optimum, 2 for the best solutions), to up to maxSolutions solutions.
+ * It returns -1 if Gurobi had an error, and 0 otherwise.
+ */
+int setILPPool(int mode, int maxSolutions){
+    GRBenv *env = GRBgetenv(ilpModel.model);
+    int error = GRBsetintparam(env, GRB_INT_PAR_POOLSEARCHMODE, mode);
+    if (!error){
+        error = GRBsetintparam(env, GRB_INT_PAR_POOLSOLUTIONS, maxSolutions);
+    }
     if (error) {
-        printf("ERROR %d GRBoptimize(): %s\n", error, GRBgeterrormsg(env));
-        freeGurobi(obj, vtype, env, model);
+        printf("ERROR %d GRBsetintparam(): %s\n", error, GRBgeterrormsg(env));
         return -1;
     }
+    return 0;
+}
 
-    /* Write model to 'mip1.lp' - this is not necessary but very helpful */
-    error = GRBwrite(model, "mip1.lp");
-    if (error) {
-        printf("ERROR %d GRBwrite(): %s\n", error, GRBgeterrormsg(env));
-        freeGurobi(obj, vtype, env, model);
+/*
+ * This method solves the current board using ILP, like solveBoardPool,
+ * and adds the time it spent in every phase to call.
+ */
+int solveILPPool(struct boardView *view, int *retBoards, int maxSolutions, int *pCount, struct solverCall *call){
+    int i, res, error, count, N = viewLen(view);
+    double since, *sol;
+
+    res = syncGurobiModel(&ilpModel, BINARY, view, call);
+    if (res){
+        return res;
+    }
+    since = monotonicSeconds();
+    res = randomizeILPObjective(N);
+    if (!res){
+        res = setILPPool(GUROBI_POOL_BEST, maxSolutions);
+    }
+    if (res){
+        return res;
+    }
+    endSolverPhase(call, modelPhase, since);
+    exportGurobiModel(&ilpModel);
+    since = monotonicSeconds();
+    res = optimizeGurobiModel(&ilpModel);
+    endSolverPhase(call, optimizePhase, since);
+    if (setILPPool(GUROBI_POOL_DEFAULT, GUROBI_DEFAULT_POOL_SOLUTIONS) == -1){ /* for the next solves */
         return -1;
     }
+    if (res != 1){
+        return res;
+    }
 
-    /* Get solution information */
-    error = GRBgetintattr(model, GRB_INT_ATTR_STATUS, &optimstatus);
+    since = monotonicSeconds();
+    error = GRBgetintattr(ilpModel.model, GRB_INT_ATTR_SOLCOUNT, &count);
     if (error) {
-        printf("ERROR %d GRBgetintattr(): %s\n", error, GRBgeterrormsg(env));
-        freeGurobi(obj, vtype, env, model);
+        printf("ERROR %d GRBgetintattr(): %s\n", error, GRBgeterrormsg(GRBgetenv(ilpModel.model)));
         return -1;
     }
-
-    /* solution found */
-    if (optimstatus == GRB_OPTIMAL) {
-        /* get the objective -- the optimal result of the function */
-        error = GRBgetdblattr(model, GRB_DBL_ATTR_OBJVAL, &objval);
-        if (error) {
-            printf("ERROR %d GRBgettdblattr(): %s\n", error, GRBgeterrormsg(env));
-            freeGurobi(obj, vtype, env, model);
-            return -1;
-        }
-
-        /* get the solution - the assignment to each variable */
-        error = GRBgetdblattrarray(model, GRB_DBL_ATTR_X, 0, amountOfVariables, sol);
-        if (error) {
-            printf("ERROR %d GRBgetdblattrarray(): %s\n", error, GRBgeterrormsg(env));
-            freeGurobi(obj, vtype, env, model);
-            return -1;
-        }
-
-        if (type != CONTINUOUS){
-            for(i = 0; i < N; i++){
-                for(j = 0; j < N; j++){
-                    index = matIndex(manager->m, manager->n, i, j);
-                    if(manager->board[index] != 0){
-                        (*retBoard)[index] = manager->board[index];
-                    }
-                    else{
-                        for (k = 0; k < N ; k++) {
-                            currIndex = indices[threeDIndex(N, i, j, k)];
-                            if((currIndex != -1) && (sol[currIndex] == 1.0)){
-                                (*retBoard)[index] = k + 1;
-                                break;
-                            }
-                        }
-                    }
-                }
-            }
-        }
+    count = (count < maxSolutions) ? count : maxSolutions;
+    sol = (double *)malloc((ilpModel.numVars + 1) * sizeof(double));
+    if (sol == NULL){
+        return -2;
     }
-    else{ /* no solution found */
-        if (optimstatus == GRB_INF_OR_UNBD) {
-            freeGurobi(obj, vtype, env, model);
-            return 0;
+    for (i = 0; i < count; i++){
+        error = GRBsetintparam(GRBgetenv(ilpModel.model), GRB_INT_PAR_SOLUTIONNUMBER, i);
+        if (!error){
+            error = GRBgetdblattrarray(ilpModel.model, GRB_DBL_ATTR_XN, 0, ilpModel.numVars, sol);
         }
-            /* error or calculation stopped */
-        else {
-            freeGurobi(obj, vtype, env, model);
+        if (error) {
+            printf("ERROR %d GRBgetdblattrarray(): %s\n", error, GRBgeterrormsg(GRBgetenv(ilpModel.model)));
+            free(sol);
             return -1;
         }
+        decodeILPSolution(view, sol, retBoards + i * N * N);
     }
-    /* free model and environment */
-    freeGurobi(obj, vtype, env, model);
-    return 1; /* if we got here, we didn't fail and there is optimal solution */
+    free(sol);
+    endSolverPhase(call, decodePhase, since);
+    *pCount = count;
+    return 1;
 }
 
 /*
- * This method solves the current board using ILP.
- * The solution is returned through retBoard.
+ * This method solves the current board using ILP, and asks Gurobi for a pool of up to maxSolutions
+ * different solutions from the same optimize.
+ * The solutions are returned one after the other through retBoards, which has room for maxSolutions
+ * boards, and their amount through *pCount.
+ * The call is recorded in the solver statistics.
  *  Return values:
+ * -4: the budget of the command ran out.
  * -2: memory allocation failed.
  * -1: Gurobi had an error.
  *  0: the board is invalid.
- *  1: the board is valid, and *retBoard is filled with a solution.
+ *  1: the board is valid, and retBoards is filled with *pCount >= 1 solutions.
  */
-int solveBoard(struct sudokuManager *manager, int **retBoard){
-    int N = boardLen(manager), amountOfVariables, res;
-    int *indices = NULL;
-    double *sol = NULL;
-    indices = init3DArray(N);
-    if (indices == NULL){
-        return -2; /* terminate program */
-    }
-    amountOfVariables = update3DIndices(manager, indices);
-
-    sol = (double*)malloc(amountOfVariables * sizeof(double));
-    if(sol == NULL){
-        free(indices);
-        return -2;
-    }
-    /* running Gurobi */
-    res = solveGurobi(manager, BINARY, retBoard, sol, indices, amountOfVariables);
-
-    free(indices);
-    free(sol);
+int solveBoardPool(struct boardView *view, int *retBoards, int maxSolutions, int *pCount){
+    struct solverCall call;
+    int res;
+    startSolverCall(&call, ilpSolver, view->m, view->n);
+    res = solveILPPool(view, retBoards, maxSolutions, pCount, &call);
+    call.numVars = ilpModel.numVars;
+    call.numConstrs = ilpModel.numConstrs;
+    recordSolverCall(&call, res);
     return res;
 }
 
 /*
- * This function counts how many legal values there are for cell <row, col> and returns it.
+ * This method solves the current board using ILP.
+ * The solution is returned through retBoard, unless retBoard == NULL.
+ * The model is kept between calls, so only the cells that changed since the last call are applied.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ * -1: Gurobi had an error.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoard is filled with a solution.
  */
-int countPossibleValues(int row, int col, double *sol, int *indices, int N){
-    int k, index, count = 0;
-    for (k = 0; k < N; k++){
-        index = threeDIndex(N, row, col, k);
-        if (indices[index] == -1 || indices[index] == -2){
-            continue;
-        }
-        if (sol[indices[index]] > 0){
-            count++;
+int solveBoard(struct boardView *view, int *retBoard){
+    return solveBoardUntil(view, retBoard, NULL);
+}
+
+/*
+ * This function solves the board seen through view, of which the hash is hash, using LP, like solveLP,
+ * and adds the time it spent in every phase to call.
+ */
+int solveLPModel(struct boardView *view, unsigned long hash, struct solverCall *call){
+    int i, j, k, count, *values, N = viewLen(view);
+    double *scores, since;
+    int res;
+    /* lpResult.index is rebuilt by the sync, so the key only holds again once the LP is solved */
+    freeRelaxationKey(&lpKey);
+    res = syncGurobiModel(&lpModel, CONTINUOUS, view, call);
+    if (res){
+        return res;
+    }
+    res = lpModel.solved;
+    if (res == -1){ /* the board changed since the last optimize */
+        exportGurobiModel(&lpModel);
+        since = monotonicSeconds();
+        res = optimizeGurobiModel(&lpModel);
+        endSolverPhase(call, optimizePhase, since);
+    }
+    if ((res == 0) && (setRelaxationKey(&lpKey, view, hash) == 0)){
+        lpKey.solved = 0;
+    }
+    if (res != 1){
+        return res;
+    }
+    since = monotonicSeconds();
+
+    scores = (double *)realloc(lpResult.scores, (lpModel.index.numCandidates + 1) * sizeof(double));
+    if (scores == NULL){
+        return -2;
+    }
+    lpResult.scores = scores;
+    lpResult.index = &(lpModel.index);
+    for (i = 0; i < N; i++){
+        for (j = 0; j < N; j++){
+            values = cellCandidates(&(lpModel.index), i, j, &count);
+            for (k = 0; k < count; k++){
+                *(scores++) = lpModel.sol[lpModel.varOf[threeDIndex(N, i, j, values[k])]];
+            }
         }
     }
-    return count;
+    endSolverPhase(call, decodePhase, since);
+    if (setRelaxationKey(&lpKey, view, hash) == 0){ /* without a key the next call solves again */
+        lpKey.solved = 1;
+    }
+    return 1;
 }
 
 /*
- * This function updates the possible values and their scores for cell <row, col>.
+ * This function solves the board seen through view using LP.
+ * While the board is the one of the last call (as lpKey tells), lpResult is read as is.
+ * Otherwise the LP is optimized only if the model changed, and then it starts from the basis of the last optimize.
+ * The call is recorded in the solver statistics.
+ * Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ * -1: Gurobi had an error.
+ *  0: the board is invalid.
+ *  1: lpResult holds the LP relaxation of the board.
  */
-void updateCellPossibleValues(int row, int col, double *sol, int *indices, int N, int *cellValues, double *scores){
-    int count = 0, k, index;
-    for (k = 0; k < N; k++){
-        index = threeDIndex(N, row, col, k);
-        if ((indices[index] == -1) || (indices[index] == -2)){
-            continue;
-        }
-        if (sol[indices[index]] > 0){
-            cellValues[count] = k + 1;
-            scores[count] = sol[indices[index]];
-            count++;
-        }
+int solveLP(struct boardView *view){
+    struct solverCall call;
+    int res;
+    unsigned long hash = viewHash(view);
+    if (matchRelaxationKey(&lpKey, view, hash)){ /* the board did not change since the last call */
+        recordCachedSolverCall(lpSolver);
+        return lpKey.solved;
     }
+    startSolverCall(&call, lpSolver, view->m, view->n);
+    res = solveLPModel(view, hash, &call);
+    call.numVars = lpModel.numVars;
+    call.numConstrs = lpModel.numConstrs;
+    recordSolverCall(&call, res);
+    return res;
 }
 
 /*
  * This function solves the current board using LP.
  *  Return values:
+ * -4: the budget of the command ran out.
  * -2: memory allocation failed.
  * -1: Gurobi had an error.
  *  0: the board is invalid.
@@ -893,167 +1246,33 @@ void updateCellPossibleValues(int row, int col, double *sol, int *indices, int N
  * The length of *pCellValues and *pScores is returned through *pLength.
  * User needs to free *pCellValues and *pScores iff return value == 1.
 */
-int guessCellValues(struct sudokuManager *manager, int row, int col,
+int guessCellValues(struct boardView *view, int row, int col,
                     int **pCellValues, double **pScores, int *pLength){
-    int N = boardLen(manager), amountOfVariables, res;
-    int *indices = NULL, *retBoard = NULL;
-    double *sol = NULL;
-    int count = 0;
-
-    indices = init3DArray(N);
-    if (indices == NULL){
-        return -2; /* terminate program */
-    }
-
-    amountOfVariables = update3DIndices(manager, indices);
-
-    sol = (double*)malloc(amountOfVariables * sizeof(double));
-    if(sol == NULL){
-        free(indices);
-        return -2;
-    }
     /* running Gurobi */
-    res = solveGurobi(manager, CONTINUOUS, &retBoard, sol, indices, amountOfVariables);
-    if ((res == -1) || (res == -2) || (res == 0)){
-        free(indices);
-        free(sol);
+    int res = solveLP(view);
+    if (res != 1){
         return res;
     }
-
-    count = countPossibleValues(row, col, sol, indices, N);
-    if (count == 0){ /* there is no possible value for <row, col>*/
-        free(indices);
-        free(sol);
-        return 0;
-    }
-
-    *pScores = (double *)malloc(count * sizeof(double));
-    *pCellValues = (int *)malloc(count * sizeof(int));
-
-    if ((*pCellValues == NULL) || (*pScores == NULL)){
-        free(*pScores);
-        free(*pCellValues);
-        free(indices);
-        free(sol);
-        return -2;
-    }
-    *pLength = count;
-    updateCellPossibleValues(row, col, sol, indices, N, *pCellValues, *pScores);
-
-    free(indices);
-    free(sol);
-    return 1;
-}
-
-/*
- * This function fills availableValues with the legal values for cell <row, col> of which the
- * score is above threshold, and fills their score in the array scores accordingly.
- * It returns its length in *pLength and scores' sum of the available values (the sum of scores array)
- * in *pSumScores.
- */
-void createAvailableValues(struct sudokuManager *manager, int *availableValues, float *scores, float threshold,
-                           int *indices, double *sol, int *pLength, float *pSumScores, int row, int col, int *retBoard){
-    int k, index, N = boardLen(manager);
-    *pLength = 0;
-    *pSumScores = 0;
-    for (k = 0; k < N; k++){
-        index = threeDIndex(N, row, col, k);
-        if (indices[index] == -1 || indices[index] == -2){
-            /* this value was erroneous from the first place or contained a value */
-            continue;
-        }
-        if (sol[indices[index]] >= threshold){ /* score is above the threshold we got */
-            if (!neighbourContainsOnce(retBoard, manager->m, manager->n, row, col, k + 1)){
-                /* value is not erroneous for this cell */
-                availableValues[*pLength] = k + 1;
-                scores[*pLength] = (float)(sol[indices[index]]);
-                (*pSumScores) += scores[*pLength];
-                (*pLength)++;
-            }
-        }
-    }
+    return relaxationCellValues(&lpResult, row, col, pCellValues, pScores, pLength);
 }
 
 /*
  * This function solves the current board using LP.
- * retBoard is a copy of manager->board.
+ * retBoard is a copy of the board seen through view.
+ * The relaxation is rounded samples times, and the rounding which filled the most cells is kept (see roundRelaxation).
  * It fills retBoard with the solution guessed iff return value == 1.
  * Return values:
+ * -4: the budget of the command ran out.
  * -2: memory allocation failed.
  * -1: Gurobi had an error.
  *  0: the board is invalid.
  *  1: the board was successfully guessed.
 */
-int guessSolution(struct sudokuManager *manager, float threshold, int *retBoard) {
-    int N = boardLen(manager), amountOfVariables, res;
-    int *indices = NULL, *retBoardGurobi = NULL;
-    double *sol = NULL;
-    int i, j, k, length;
-    int *availableValues = NULL;
-    float *scores = NULL, randScore, sumScores, currScore;
-    /* scores is an array of matching scores to availableValues */
-    indices = init3DArray(N);
-    if (indices == NULL) {
-        return -2; /* terminate program */
-    }
-
-    amountOfVariables = update3DIndices(manager, indices);
-
-    sol = (double *) malloc(amountOfVariables * sizeof(double));
-    if (sol == NULL) {
-        free(indices);
-        return -2;
-    }
+int guessSolution(struct boardView *view, float threshold, int samples, int *retBoard) {
     /* running Gurobi */
-    res = solveGurobi(manager, CONTINUOUS, &retBoardGurobi, sol, indices, amountOfVariables);
-    if (res == -1 || res == -2 || res == 0){
-        free(indices);
-        free(sol);
+    int res = solveLP(view);
+    if (res != 1){
         return res;
     }
-
-    availableValues = (int *)calloc(N, sizeof(int));
-    scores = (float *)calloc(N, sizeof(float));
-
-    if (availableValues == NULL || scores == NULL){
-        free(indices);
-        free(sol);
-        free(availableValues);
-        free(scores);
-        return -2;
-    }
-
-    for (i = 0; i < N; i++){
-        for (j = 0; j < N; j++){
-            if (retBoard[matIndex(manager->m, manager->n, i, j)] != 0){
-                /* if the cell is not empty, we need to continue to the next cell */
-                continue;
-            }
-            /* length is the actual length of availableValues and scores */
-            /* sumScores is the sum of scores of available values for cell <i, j> */
-            createAvailableValues(manager, availableValues, scores, threshold,
-                                 indices, sol, &length, &sumScores, i, j, retBoard);
-            randScore = (((float)(rand())) / RAND_MAX) * sumScores;
-            /* getting a random number between 0 and sumScores */
-            currScore = 0;
-            for (k = 0; k < length; k++){
-                if ((randScore >= currScore) && (randScore <= scores[k] + currScore)){
-                    /* updating the board if the randScore tells us to choose avialableValues[k] */
-                    changeCellValue(retBoard, manager->m, manager->n, i, j, availableValues[k]);
-                    break;
-                }
-                else{
-                    currScore += scores[k];
-                    /* updating the current score, which is the sum of
-                     * all scores before the current available value */
-                }
-            }
-        }
-    }
-
-    free(indices);
-    free(sol);
-    free(availableValues);
-    free(scores);
-    return 1;
+    return roundRelaxation(&lpResult, view, threshold, samples, retBoard);
 }
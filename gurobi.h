@@ -2,12 +2,14 @@
  * This module is meant to deal everything that has to do with Gurobi.
  * It creates variables and constraints meant to solve the sudoku board in different ways using Gurobi
  * and has functions that use this solution in several ways.
+ * Every solve is recorded in the solver statistics (util/solver_stats.h).
  */
 
 #ifndef SOFTWAREPROJECTFINALPROJECT_GUROBI_H
 #define SOFTWAREPROJECTFINALPROJECT_GUROBI_H
 
 #include "util/board_manager.h"
+#include "util/board_view.h"
 #include "main_aux.h"
 #include "solver.h"
 
@@ -17,20 +19,62 @@ typedef enum {
     CONTINUOUS = 2
 } GurobiOption;
 
+/*
+ * This function starts creating the session's Gurobi environment in the background,
+ * so the first solve does not wait for it.
+ */
+void warmGurobiEnvironment();
+
+/*
+ * This function frees the session's Gurobi model and environment.
+ * It is created again on the next solve.
+ */
+void freeGurobiEnvironment();
+
+/*
+ * This method solves the current board using ILP, and asks Gurobi for a pool of up to maxSolutions
+ * different solutions from the same optimize.
+ * The solutions are returned one after the other through retBoards, which has room for maxSolutions
+ * boards, and their amount through *pCount.
+ * The call is recorded in the solver statistics.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ * -1: Gurobi had an error.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoards is filled with *pCount >= 1 solutions.
+ */
+int solveBoardPool(struct boardView *view, int *retBoards, int maxSolutions, int *pCount);
+
 /*
  * This method solves the current board using ILP.
- * The solution is returned through retBoard.
+ * The solution is returned through retBoard, unless retBoard == NULL.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ * -1: Gurobi had an error.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoard is filled with a solution.
+ */
+int solveBoard(struct boardView *view, int *retBoard);
+
+/*
+ * This method solves the current board using ILP, like solveBoard,
+ * but gives up once *stop is set by another thread (unless stop == NULL).
  *  Return values:
+ * -4: the budget of the command ran out.
+ * -3: the solve was stopped.
  * -2: memory allocation failed.
  * -1: Gurobi had an error.
  *  0: the board is invalid.
- *  1: the board is valid, and *retBoard is filled with a solution.
+ *  1: the board is valid, and retBoard is filled with a solution.
  */
-int solveBoard(struct sudokuManager *manager, int **retBoard);
+int solveBoardUntil(struct boardView *view, int *retBoard, volatile int *stop);
 
 /*
  * This function solves the current board using LP.
  *  Return values:
+ * -4: the budget of the command ran out.
  * -2: memory allocation failed.
  * -1: Gurobi had an error.
  *  0: the board is invalid.
@@ -39,20 +83,22 @@ int solveBoard(struct sudokuManager *manager, int **retBoard);
  * The length of *pCellValues and *pScores is returned through *pLength.
  * User needs to free *pCellValues and *pScores iff return value == 1.
 */
-int guessCellValues(struct sudokuManager *manager, int row, int col,
+int guessCellValues(struct boardView *view, int row, int col,
                     int **pCellValues, double **pScores, int *pLength);
 
 /*
  * This function solves the current board using LP.
- * retBoard is a copy of manager->board.
+ * retBoard is a copy of the board seen through view.
+ * The relaxation is rounded samples times, and the rounding which filled the most cells is kept (see roundRelaxation).
  * It fills retBoard with the solution guessed iff return value == 1.
  * Return values:
+ * -4: the budget of the command ran out.
  * -2: memory allocation failed.
  * -1: Gurobi had an error.
  *  0: the board is invalid.
  *  1: the board was successfully guessed.
  */
-int guessSolution(struct sudokuManager *manager,
-                  float threshold, int *retBoard);
+int guessSolution(struct boardView *view,
+                  float threshold, int samples, int *retBoard);
 
 #endif
@@ -0,0 +1,390 @@
+/*
+ * This module turns the LP relaxation of a board into guesses, whichever backend solved it.
+ * A relaxation scores every legal value of every empty cell between 0 and 1, such that the scores
+ * of every empty cell, and of every row/column/block and value missing from it, sum up to 1.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "lp_relaxation.h"
+#include "util/board_manager.h"
+#include "util/random.h"
+
+/*
+ * The roundings of a relaxation guess makes, which its workers share under lock.
+ */
+struct roundingSamples {
+    struct lpRelaxation *lp;
+    struct boardView *view;
+    float threshold;
+    int *board; /* the board every rounding starts from */
+    int count;
+    unsigned long seed; /* rounding number i draws from stream i of seed */
+    int next; /* the next rounding for a worker to take */
+    int *best; /* the rounding which filled the most cells so far */
+    int bestFilled;
+    int bestSample;
+    int failed; /* 1 once memory allocation failed, after which no rounding is taken */
+    pthread_mutex_t lock;
+};
+
+/*
+ * This method returns 1 if key holds a solved relaxation of the board seen through view,
+ * of which the hash is hash, and 0 otherwise.
+ */
+int matchRelaxationKey(struct relaxationKey *key, struct boardView *view, unsigned long hash){
+    int row, col, N = viewLen(view);
+    if ((key->board == NULL) || (key->solved == -1) || (key->hash != hash)
+        || (key->m != view->m) || (key->n != view->n)){
+        return 0;
+    }
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            if (key->board[row * N + col] != viewCell(view, row, col)){
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/*
+ * This function sets key to the board seen through view, of which the hash is hash,
+ * with the relaxation not solved yet.
+ * Return values:
+ * -2: memory allocation failed, and key holds no board.
+ *  0: key was set.
+ */
+int setRelaxationKey(struct relaxationKey *key, struct boardView *view, unsigned long hash){
+    int row, col, N = viewLen(view);
+    if ((key->board == NULL) || (key->m != view->m) || (key->n != view->n)){
+        freeRelaxationKey(key);
+        key->board = (int *)malloc(N * N * sizeof(int));
+        if (key->board == NULL){
+            return -2;
+        }
+    }
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            key->board[row * N + col] = viewCell(view, row, col);
+        }
+    }
+    key->hash = hash;
+    key->m = view->m;
+    key->n = view->n;
+    key->solved = -1;
+    return 0;
+}
+
+/*
+ * This function frees the board of key, so it holds no relaxation.
+ */
+void freeRelaxationKey(struct relaxationKey *key){
+    free(key->board);
+    key->board = NULL;
+    key->m = key->n = 0;
+    key->solved = -1;
+}
+
+/*
+ * This function counts how many values of cell <row, col> have a positive score and returns it.
+ */
+int countPossibleValues(struct lpRelaxation *lp, int row, int col){
+    int k, count, *values, possible = 0;
+    double *scores;
+    values = cellCandidates(lp->index, row, col, &count);
+    scores = lp->scores + (values - lp->index->cellValues);
+    for (k = 0; k < count; k++){
+        if (scores[k] > 0){
+            possible++;
+        }
+    }
+    return possible;
+}
+
+/*
+ * This function updates the possible values and their scores for cell <row, col>.
+ */
+void updateCellPossibleValues(struct lpRelaxation *lp, int row, int col, int *cellValues, double *scores){
+    int k, count, *values, possible = 0;
+    double *lpScores;
+    values = cellCandidates(lp->index, row, col, &count);
+    lpScores = lp->scores + (values - lp->index->cellValues);
+    for (k = 0; k < count; k++){
+        if (lpScores[k] > 0){
+            cellValues[possible] = values[k] + 1;
+            scores[possible] = lpScores[k];
+            possible++;
+        }
+    }
+}
+
+/*
+ * This function returns the values of empty cell <row, col> which have a positive score in lp
+ * through *pCellValues, and their scores through *pScores.
+ * The length of *pCellValues and *pScores is returned through *pLength.
+ *  Return values:
+ * -2: memory allocation failed.
+ *  0: there is no possible value for cell <row, col>.
+ *  1: cell <row, col> values were successfully guessed.
+ * User needs to free *pCellValues and *pScores iff return value == 1.
+ */
+int relaxationCellValues(struct lpRelaxation *lp, int row, int col,
+                         int **pCellValues, double **pScores, int *pLength){
+    int count = countPossibleValues(lp, row, col);
+    if (count == 0){ /* there is no possible value for <row, col>*/
+        return 0;
+    }
+
+    *pScores = (double *)malloc(count * sizeof(double));
+    *pCellValues = (int *)malloc(count * sizeof(int));
+
+    if ((*pCellValues == NULL) || (*pScores == NULL)){
+        free(*pScores);
+        free(*pCellValues);
+        return -2;
+    }
+    *pLength = count;
+    updateCellPossibleValues(lp, row, col, *pCellValues, *pScores);
+    return 1;
+}
+
+/*
+ * This method returns the flag of value val (1-based) in unit unit of the given type (0 for the rows,
+ * 1 for the columns and 2 for the blocks) in used, the occupancy of the units of a board of length N.
+ */
+unsigned char *unitUsedFlag(unsigned char *used, int N, int type, int unit, int val){
+    return used + (type * N + unit) * N + (val - 1);
+}
+
+/*
+ * This function marks value val (1-based) of cell <row, col> as used in the row, column and block of the cell.
+ */
+void markCellUsed(unsigned char *used, int m, int n, int row, int col, int val){
+    int N = m * n;
+    *unitUsedFlag(used, N, 0, row, val) = 1;
+    *unitUsedFlag(used, N, 1, col, val) = 1;
+    *unitUsedFlag(used, N, 2, blockNum(m, n, row, col), val) = 1;
+}
+
+/*
+ * This method returns 1 if value val (1-based) is used in the row, column or block of cell <row, col>,
+ * and 0 otherwise.
+ */
+int isUsedByNeighbour(unsigned char *used, int m, int n, int row, int col, int val){
+    int N = m * n;
+    return *unitUsedFlag(used, N, 0, row, val) || *unitUsedFlag(used, N, 1, col, val) ||
+           *unitUsedFlag(used, N, 2, blockNum(m, n, row, col), val);
+}
+
+/*
+ * This function fills availableValues with the legal values for cell <row, col> of which the
+ * score is above threshold, and fills their score in the array scores accordingly.
+ * used is the occupancy of the units of the board being guessed (see markCellUsed).
+ * It returns its length in *pLength and scores' sum of the available values (the sum of scores array)
+ * in *pSumScores.
+ */
+void createAvailableValues(struct lpRelaxation *lp, struct boardView *view, int *availableValues, float *scores,
+                           float threshold, int *pLength, float *pSumScores, int row, int col, unsigned char *used){
+    int i, count, *values;
+    double *lpScores;
+    *pLength = 0;
+    *pSumScores = 0;
+    values = cellCandidates(lp->index, row, col, &count);
+    lpScores = lp->scores + (values - lp->index->cellValues);
+    for (i = 0; i < count; i++){ /* only the values legal on the board seen through view */
+        if (lpScores[i] >= threshold){ /* score is above the threshold we got */
+            if (!isUsedByNeighbour(used, view->m, view->n, row, col, values[i] + 1)){
+                /* value is not erroneous for this cell */
+                availableValues[*pLength] = values[i] + 1;
+                scores[*pLength] = (float)lpScores[i];
+                (*pSumScores) += scores[*pLength];
+                (*pLength)++;
+            }
+        }
+    }
+}
+
+/*
+ * This function rounds lp, the relaxation of the board seen through view, once into a guessed solution,
+ * drawing from random. retBoard is a copy of the board seen through view. Every empty cell of it is filled,
+ * in turn, with a value raffled by the scores, among the values scored at least threshold
+ * which are legal with the cells filled before it. A cell with no such value stays empty.
+ * The values every row, column and block already holds are kept as flags, updated with every cell filled,
+ * so checking that a value is legal takes a single lookup.
+ * It returns -2 if memory allocation failed, and otherwise the number of cells it filled.
+ */
+int roundRelaxationOnce(struct lpRelaxation *lp, struct boardView *view, float threshold,
+                        struct randomStream *random, int *retBoard){
+    int N = viewLen(view);
+    int i, j, k, length, cell, filled = 0;
+    int *availableValues = NULL;
+    unsigned char *used = NULL;
+    float *scores = NULL, randScore, sumScores, currScore;
+    /* scores is an array of matching scores to availableValues */
+
+    availableValues = (int *)calloc(N, sizeof(int));
+    scores = (float *)calloc(N, sizeof(float));
+    used = (unsigned char *)calloc(3 * N * N, sizeof(unsigned char));
+
+    if (availableValues == NULL || scores == NULL || used == NULL){
+        free(availableValues);
+        free(scores);
+        free(used);
+        return -2;
+    }
+    for (i = 0; i < N; i++){
+        for (j = 0; j < N; j++){
+            if (retBoard[matIndex(view->m, view->n, i, j)] != 0){
+                markCellUsed(used, view->m, view->n, i, j, retBoard[matIndex(view->m, view->n, i, j)]);
+            }
+        }
+    }
+
+    for (i = 0; i < N; i++){
+        for (j = 0; j < N; j++){
+            cell = matIndex(view->m, view->n, i, j);
+            if (retBoard[cell] != 0){
+                /* if the cell is not empty, we need to continue to the next cell */
+                continue;
+            }
+            /* length is the actual length of availableValues and scores */
+            /* sumScores is the sum of scores of available values for cell <i, j> */
+            createAvailableValues(lp, view, availableValues, scores, threshold,
+                                  &length, &sumScores, i, j, used);
+            if (length == 0){ /* the cell stays empty, without drawing a number */
+                continue;
+            }
+            randScore = (float)(randomUnit(random) * sumScores);
+            /* getting a random number between 0 and sumScores */
+            currScore = 0;
+            for (k = 0; k < length - 1; k++){ /* the last value takes whatever rounding left over */
+                currScore += scores[k];
+                if (randScore < currScore){
+                    break;
+                }
+            }
+            /* updating the board with the value randScore tells us to choose */
+            retBoard[cell] = availableValues[k];
+            markCellUsed(used, view->m, view->n, i, j, availableValues[k]);
+            filled++;
+        }
+    }
+
+    free(availableValues);
+    free(scores);
+    free(used);
+    return filled;
+}
+
+/*
+ * This function is a worker of samples: it rounds the samples it takes, until none are left,
+ * and keeps every sample which filled more cells than the best one so far.
+ */
+void *runRoundingWorker(void *arg){
+    struct roundingSamples *samples = (struct roundingSamples *)arg;
+    struct randomStream random;
+    int i, j, filled, area = viewLen(samples->view) * viewLen(samples->view), *board;
+
+    board = (int *)malloc(area * sizeof(int));
+    if (board == NULL){
+        pthread_mutex_lock(&(samples->lock));
+        samples->failed = 1;
+        pthread_mutex_unlock(&(samples->lock));
+        return NULL;
+    }
+    while (1){
+        pthread_mutex_lock(&(samples->lock));
+        i = (samples->failed || (samples->next == samples->count)) ? -1 : samples->next++;
+        pthread_mutex_unlock(&(samples->lock));
+        if (i == -1){
+            break;
+        }
+        for (j = 0; j < area; j++){
+            board[j] = samples->board[j];
+        }
+        seedRandom(&random, samples->seed, (unsigned long)i);
+        filled = roundRelaxationOnce(samples->lp, samples->view, samples->threshold, &random, board);
+        pthread_mutex_lock(&(samples->lock));
+        if (filled == -2){
+            samples->failed = 1;
+        }
+        else if ((filled > samples->bestFilled) || ((filled == samples->bestFilled) && (i < samples->bestSample))){
+            /* ties go to the first sample, so the best one does not depend on the threads */
+            for (j = 0; j < area; j++){
+                samples->best[j] = board[j];
+            }
+            samples->bestFilled = filled;
+            samples->bestSample = i;
+        }
+        pthread_mutex_unlock(&(samples->lock));
+    }
+    free(board);
+    return NULL;
+}
+
+/*
+ * This function rounds lp, the relaxation of the board seen through view, into a guessed solution,
+ * count times, and keeps the one which filled the most cells in retBoard.
+ * retBoard is a copy of the board seen through view. Every rounding fills every empty cell of it, in turn,
+ * with a value raffled by the scores, among the values scored at least threshold
+ * which are legal with the cells filled before it. A cell with no such value stays empty.
+ * A single rounding draws from the stream of the session. Otherwise rounding number i draws from stream i
+ * of a seed drawn from it, and the roundings run on a worker thread per online processor,
+ * so the guess depends only on the seed, and not on the number of threads.
+ * Return values:
+ * -2: memory allocation failed.
+ *  1: the board was successfully guessed.
+ */
+int roundRelaxation(struct lpRelaxation *lp, struct boardView *view, float threshold, int count, int *retBoard){
+    struct roundingSamples samples;
+    pthread_t *workers;
+    int i, threads, started = 0, area = viewLen(view) * viewLen(view);
+
+    if (count == 1){
+        return (roundRelaxationOnce(lp, view, threshold, sessionRandom(), retBoard) == -2) ? -2 : 1;
+    }
+    samples.lp = lp;
+    samples.view = view;
+    samples.threshold = threshold;
+    samples.board = retBoard;
+    samples.count = count;
+    samples.seed = nextRandom(sessionRandom());
+    samples.next = 0;
+    samples.bestFilled = -1;
+    samples.bestSample = count;
+    samples.failed = 0;
+    threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    threads = (threads < 1) ? 1 : ((threads > count) ? count : threads);
+    samples.best = (int *)malloc(area * sizeof(int));
+    workers = (pthread_t *)malloc(threads * sizeof(pthread_t));
+    if ((samples.best == NULL) || (workers == NULL) || (pthread_mutex_init(&(samples.lock), NULL) != 0)){
+        free(samples.best);
+        free(workers);
+        return -2;
+    }
+
+    /* the calling thread is one of the workers, so the roundings run even if no thread can start */
+    for (i = 0; i < threads - 1; i++){
+        if (pthread_create(&workers[started], NULL, runRoundingWorker, &samples) == 0){
+            started++;
+        }
+    }
+    runRoundingWorker(&samples);
+    for (i = 0; i < started; i++){
+        pthread_join(workers[i], NULL);
+    }
+
+    pthread_mutex_destroy(&(samples.lock));
+    if (!samples.failed){
+        for (i = 0; i < area; i++){
+            retBoard[i] = samples.best[i];
+        }
+    }
+    free(samples.best);
+    free(workers);
+    return samples.failed ? -2 : 1;
+}
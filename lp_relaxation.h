@@ -0,0 +1,79 @@
+/*
+ * This module turns the LP relaxation of a board into guesses, whichever backend solved it.
+ * A relaxation scores every legal value of every empty cell between 0 and 1, such that the scores
+ * of every empty cell, and of every row/column/block and value missing from it, sum up to 1.
+ */
+
+#ifndef SOFTWAREPROJECTFINALPROJECT_LP_RELAXATION_H
+#define SOFTWAREPROJECTFINALPROJECT_LP_RELAXATION_H
+
+#include "util/board_view.h"
+#include "util/candidate_index.h"
+
+struct lpRelaxation {
+    struct candidateIndex *index; /* the candidates of the relaxed board */
+    double *scores; /* the score of every candidate, in the order of index->cellValues */
+};
+
+/*
+ * The board the last relaxation of a backend was solved for, which guess, guess_hint and guess_hint_all
+ * read the relaxation from while the board stays the same.
+ * Boards are told apart by their hash (viewHash), and only a board with the same hash is compared cell by cell.
+ */
+struct relaxationKey {
+    unsigned long hash;
+    int m;
+    int n;
+    int *board; /* N*N, or NULL if there is no relaxation */
+    int solved; /* the result of solving the relaxation (0 or 1), or -1 while it is not solved */
+};
+
+/*
+ * This method returns 1 if key holds a solved relaxation of the board seen through view,
+ * of which the hash is hash, and 0 otherwise.
+ */
+int matchRelaxationKey(struct relaxationKey *key, struct boardView *view, unsigned long hash);
+
+/*
+ * This function sets key to the board seen through view, of which the hash is hash,
+ * with the relaxation not solved yet.
+ * Return values:
+ * -2: memory allocation failed, and key holds no board.
+ *  0: key was set.
+ */
+int setRelaxationKey(struct relaxationKey *key, struct boardView *view, unsigned long hash);
+
+/*
+ * This function frees the board of key, so it holds no relaxation.
+ */
+void freeRelaxationKey(struct relaxationKey *key);
+
+/*
+ * This function returns the values of empty cell <row, col> which have a positive score in lp
+ * through *pCellValues, and their scores through *pScores.
+ * The length of *pCellValues and *pScores is returned through *pLength.
+ *  Return values:
+ * -2: memory allocation failed.
+ *  0: there is no possible value for cell <row, col>.
+ *  1: cell <row, col> values were successfully guessed.
+ * User needs to free *pCellValues and *pScores iff return value == 1.
+ */
+int relaxationCellValues(struct lpRelaxation *lp, int row, int col,
+                         int **pCellValues, double **pScores, int *pLength);
+
+/*
+ * This function rounds lp, the relaxation of the board seen through view, into a guessed solution,
+ * count times, and keeps the one which filled the most cells in retBoard.
+ * retBoard is a copy of the board seen through view. Every rounding fills every empty cell of it, in turn,
+ * with a value raffled by the scores, among the values scored at least threshold
+ * which are legal with the cells filled before it. A cell with no such value stays empty.
+ * A single rounding draws from the stream of the session. Otherwise rounding number i draws from stream i
+ * of a seed drawn from it, and the roundings run on a worker thread per online processor,
+ * so the guess depends only on the seed, and not on the number of threads.
+ * Return values:
+ * -2: memory allocation failed.
+ *  1: the board was successfully guessed.
+ */
+int roundRelaxation(struct lpRelaxation *lp, struct boardView *view, float threshold, int count, int *retBoard);
+
+#endif
@@ -1,7 +1,20 @@
 #include "game.h"
+#include "backend.h"
+#include "main_aux.h"
 #include <stdio.h>
+#include <string.h>
 
-int main() {
+int main(int argc, char *argv[]) {
+    int i;
+
+    for (i = 1; i < argc; i++){
+        if (!strcmp(argv[i], "--warm-gurobi")){ /* create the Gurobi environment in the background */
+            warmUpBackends();
+        }
+        else{
+            printUnknownOption(argv[i]);
+        }
+    }
 
     startGame();
 
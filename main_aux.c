@@ -11,10 +11,12 @@
 #define title2    "     `7MM  `7MM     ,M\"\"bMM    ,pW\"Wq.     MM  ,MP'  `7MM  `7MM  \n  `YMMNq.   MM    MM   ,AP    MM   6W'   `Wb    MM ;Y       MM    MM  \n.     `MM   MM    MM   8MI    MM   8M     M8    MM;Mm       MM    MM  \nMb     dM   MM    MM   `Mb    MM   YA.   ,A9    MM `Mb.     MM    MM  \nP\"Ybmmd\"    `Mbod\"YML.  `Wbmd\"MML.  `Ybmd9'.   JMML. YA.    `Mbod\"YML."
 #define creators "Din Moshe and Doron Antebi"
 
-#define commandListLength 17
+#define commandListLength 27
 static char* commandList[] = {"solve", "edit", "mark_errors", "print_board", "set", "validate",
                               "guess", "generate", "undo", "redo", "save", "hint", "guess_hint",
-                              "num_solutions", "autofill", "reset", "exit"};
+                              "num_solutions", "autofill", "reset", "exit", "backend", "budget",
+                              "solver_stats", "guess_hint_all", "generate_unique",
+                              "generate_batch", "seed", "grade", "generate_graded", "goto_move"};
 
 /* GENERAL GAME RELATED METHODS */
 
@@ -39,6 +41,13 @@ void printExitMessage(){
     printf("Bye bye! (:\n");
 }
 
+/*
+ * This function prints that a command line option of the program is unknown.
+ */
+void printUnknownOption(char *option){
+    printf("Error: unknown option %s was ignored.\n", option);
+}
+
 /* BOARD PRINT AUXILIARY FUNCTIONS */
 
 /*
@@ -314,6 +323,13 @@ void printReset(){
     printf("Board returned to its initial state.\n");
 }
 
+/*
+ * This function prints that the board was brought to the state after move number move, of numMoves moves.
+ */
+void printWentToMove(int move, int numMoves){
+    printf("Board went to its state after move %d of %d.\n", move, numMoves);
+}
+
 /* BOARD */
 
 /*
@@ -375,7 +391,96 @@ void printBoardIsValid(){
  * solving the board in all its attempts.
  */
 void printGenerateFailed(){
-    printf("Error: board generation failed after 1000 attempts.\n");
+    printf("Error: board generation failed, the board has no solution.\n");
+}
+
+/*
+ * This function prints how many cells the board generated by generate_unique has filled.
+ */
+void printUniqueGenerated(int givens){
+    printf("The generated board has a single solution, and %d filled cells.\n", givens);
+}
+
+/*
+ * This function prints the seed the random numbers of the session are drawn from.
+ */
+void printSessionSeed(unsigned long seed){
+    printf("The random seed is %lu.\n", seed);
+}
+
+/*
+ * This function prints how many of the count boards of generate_batch were written to path.
+ */
+void printBatchWritten(int written, int count, char *path){
+    printf("%d of %d boards were written to %s.\n", written, count, path);
+}
+
+/*
+ * This function prints that the boards of generate_batch could not be written to path.
+ */
+void printBatchFileFailed(char *path){
+    printf("Error: the boards could not be written to %s.\n", path);
+}
+
+/*
+ * This function prints that generate_batch only makes boards of length up to maxLen.
+ */
+void printBatchTooLong(int maxLen){
+    printf("Error: only boards of length up to %d can be generated in a batch.\n", maxLen);
+}
+
+/*
+ * This function prints that option is not an option of the generate_unique command.
+ */
+void printUnknownGenerateUniqueOption(char *option){
+    printf("Error: %s is not an option of the generate_unique command.\n"
+           "The only option is minimal, which keeps emptying cells until none can be emptied.\n", option);
+}
+
+/*
+ * This function prints how many cells the best of the samples roundings of guess filled.
+ */
+void printBestGuess(int samples, int filled){
+    printf("The best of %d guesses filled %d cells.\n", samples, filled);
+}
+
+/*
+ * This function prints the grade of a board: its hardest technique, and the steps of every technique it used.
+ */
+void printBoardGrade(struct boardGrade *grade){
+    int t;
+    char *separator = ":";
+    printf("The board is graded %s, after %d steps", gradeTechniqueName(grade->hardest), grade->steps);
+    for (t = 0; t < NUM_GRADE_TECHNIQUES; t++){
+        if (grade->stepsBy[t] > 0){
+            printf("%s %d %s", separator, grade->stepsBy[t], gradeTechniqueName((enum gradeTechnique)t));
+            separator = ",";
+        }
+    }
+    printf(".\n");
+}
+
+/*
+ * This function prints that boards longer than maxLen can not be graded.
+ */
+void printGradeTooLong(int maxLen){
+    printf("Error: only boards of length up to %d can be graded.\n", maxLen);
+}
+
+/*
+ * This function prints that name is not the name of a grade.
+ */
+void printUnknownGrade(char *name){
+    printf("Error: there is no grade named %s.\n"
+           "The grades are: naked_single, hidden_single, locked_candidates, naked_subset, hidden_subset, fish, "
+           "chain, search.\n", name);
+}
+
+/*
+ * This function prints that none of the attempts boards generate_graded made was of the grade named name.
+ */
+void printGradeNotGenerated(char *name, int attempts){
+    printf("Error: none of the %d boards generated was graded %s, the board was not changed.\n", attempts, name);
 }
 
 /*
@@ -420,6 +525,29 @@ void printValuesAndScores(int row, int col, int *array, double *scores, int leng
     printf("]\n");
 }
 
+/*
+ * This function prints the possible values and their scores for every cell of an N*N board,
+ * calculated by "guessHintAll". The values of cell <row, col> are values[starts[cell]..starts[cell + 1] - 1],
+ * where cell = row * N + col, and cells with no values are left out.
+ */
+void printScoreTable(int N, int *values, double *scores, int *starts){
+    int row, col, k, cell;
+    printf("The legal values for every empty cell and their scores are:\n");
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            cell = row * N + col;
+            if (starts[cell] == starts[cell + 1]){
+                continue;
+            }
+            printf("<%d,%d>: [ ", col + 1, row + 1);
+            for (k = starts[cell]; k < starts[cell + 1]; k++){
+                printf("(%d, %.2f) ", values[k], scores[k]);
+            }
+            printf("]\n");
+        }
+    }
+}
+
 /*
  * This function prints the hint for the cell, as the user requested.
  * The format of cell print is <col, row>, similar to "set".
@@ -428,6 +556,129 @@ void printHint(int row, int col, int hint){
     printf("Hint: set cell <%d,%d> to %d.\n", col + 1, row + 1, hint);
 }
 
+/* SOLVER BACKEND RELATED */
+
+/*
+ * This function prints that the solver backend is now backendName.
+ */
+void printBackendSelected(char *backendName){
+    printf("The solver backend is now %s.\n", backendName);
+}
+
+/*
+ * This function prints that there is no solver backend named backendName.
+ */
+void printUnknownBackend(char *backendName){
+    printf("Error: there is no solver backend named %s.\n"
+           "The available backends are: race, gurobi, native, sat.\n", backendName);
+}
+
+/*
+ * This function prints that the solver backend backendName is not included in this build.
+ */
+void printBackendNotBuilt(char *backendName){
+    printf("Error: the %s backend is not included in this build.\n", backendName);
+}
+
+/* BUDGET RELATED */
+
+/*
+ * This function prints that the solver ran out of the budget of the command before it finished.
+ */
+void printBudgetExhausted(){
+    printf("Error: the command ran out of its budget before the solver finished.\n"
+           "Raise the limit with the budget command, or set it to 0 for no limit.\n");
+}
+
+/*
+ * This function prints that there is no budget named kindName.
+ */
+void printUnknownBudget(char *kindName){
+    printf("Error: there is no budget named %s.\n"
+           "The available budgets are: time, nodes, iterations.\n", kindName);
+}
+
+/*
+ * This function prints the limit every command now has on the budget named kindName, in unit.
+ * A limit of 0 means there is no limit.
+ */
+void printBudgetSet(char *kindName, double limit, char *unit){
+    if (limit == 0){
+        printf("The %s budget of every command is now unlimited.\n", kindName);
+    }
+    else{
+        printf("The %s budget of every command is now %g %s.\n", kindName, limit, unit);
+    }
+}
+
+/* SOLVER STATISTICS RELATED */
+
+/*
+ * This function prints the totals of the solver named name, and its last call.
+ */
+void printSolverTotals(char *name, struct solverTotals *totals){
+    struct solverCall *last = &(totals->last);
+    printf("%s: %ld calls, and %ld more answered from the cache.\n", name, totals->calls, totals->cachedCalls);
+    if (totals->calls == 0){
+        return;
+    }
+    printf("  %.1f variables and %.1f constraints on average.\n"
+           "  Total seconds: index %.4f, model %.4f, optimize %.4f, decode %.4f.\n",
+           totals->vars / totals->calls, totals->constrs / totals->calls,
+           totals->seconds[indexPhase], totals->seconds[modelPhase],
+           totals->seconds[optimizePhase], totals->seconds[decodePhase]);
+    printf("  Last call: %dx%d blocks, %d variables, %d constraints, "
+           "seconds: index %.4f, model %.4f, optimize %.4f, decode %.4f, result %d.\n",
+           last->m, last->n, last->numVars, last->numConstrs, last->seconds[indexPhase],
+           last->seconds[modelPhase], last->seconds[optimizePhase], last->seconds[decodePhase], last->result);
+}
+
+/*
+ * This function prints that no solver was called yet.
+ */
+void printNoSolverCalls(){
+    printf("No solver was called yet.\n");
+}
+
+/*
+ * This function prints the races the race backend ran over m*n boards of which
+ * the given quarter of the cells is filled, and how many each side won.
+ */
+void printRaceRecord(int m, int n, int filledQuarter, long gurobiWins, long nativeWins){
+    printf("Races over %dx%d blocks boards, %d%%-%d%% filled: gurobi won %ld, native won %ld.\n",
+           m, n, filledQuarter * 25, (filledQuarter + 1) * 25, gurobiWins, nativeWins);
+}
+
+/*
+ * This function prints where the solver log and the model export are written, if anywhere.
+ */
+void printSolverOutputs(char *logPath, char *exportPath){
+    printf("Solver log: %s. Model export: %s.\n",
+           (logPath == NULL) ? "off" : logPath, (exportPath == NULL) ? "off" : exportPath);
+}
+
+/*
+ * This function prints that the file at path could not be opened for the solver log.
+ */
+void printSolverLogFailed(char *path){
+    printf("Error: the file %s could not be opened for the solver log.\n", path);
+}
+
+/*
+ * This function prints that the path given for the model export is too long.
+ */
+void printModelExportTooLong(){
+    printf("Error: the path for the model export is too long.\n");
+}
+
+/*
+ * This function prints that option is not an option of the solver_stats command.
+ */
+void printUnknownSolverStatsOption(char *option){
+    printf("Error: %s is not an option of the solver_stats command.\n"
+           "Use solver_stats with no parameters, or solver_stats log|export <file|off>.\n", option);
+}
+
 /* FILES RELATED */
 
 /*
@@ -7,6 +7,8 @@
 #define SOFTWAREPROJECTFINALPROJECT_MAIN_AUX_H
 
 #include "util/board_manager.h"
+#include "util/solver_stats.h"
+#include "grader.h"
 
 /* GENERAL GAME RELATED METHODS */
 
@@ -25,6 +27,11 @@ void printBoardIsSolved();
  */
 void printExitMessage();
 
+/*
+ * This function prints that a command line option of the program is unknown.
+ */
+void printUnknownOption(char *option);
+
 /*
  * This method prints the users board
  */
@@ -142,6 +149,11 @@ void printActionWasMade(int row, int col, int prevVal, int newVal);
  */
 void printReset();
 
+/*
+ * This function prints that the board was brought to the state after move number move, of numMoves moves.
+ */
+void printWentToMove(int move, int numMoves);
+
 /* BOARD */
 
 /*
@@ -187,11 +199,66 @@ void printBoardNotValidError();
 void printBoardIsValid();
 
 /*
- * This function prints a message that function "generate" has failed
- * solving the board in all its attempts.
+ * This function prints a message that function "generate" has failed,
+ * as the board has no solution.
  */
 void printGenerateFailed();
 
+/*
+ * This function prints how many cells the board generated by generate_unique has filled.
+ */
+void printUniqueGenerated(int givens);
+
+/*
+ * This function prints that option is not an option of the generate_unique command.
+ */
+void printUnknownGenerateUniqueOption(char *option);
+
+/*
+ * This function prints the seed the random numbers of the session are drawn from.
+ */
+void printSessionSeed(unsigned long seed);
+
+/*
+ * This function prints how many of the count boards of generate_batch were written to path.
+ */
+void printBatchWritten(int written, int count, char *path);
+
+/*
+ * This function prints that the boards of generate_batch could not be written to path.
+ */
+void printBatchFileFailed(char *path);
+
+/*
+ * This function prints that generate_batch only makes boards of length up to maxLen.
+ */
+void printBatchTooLong(int maxLen);
+
+/*
+ * This function prints how many cells the best of the samples roundings of guess filled.
+ */
+void printBestGuess(int samples, int filled);
+
+/*
+ * This function prints the grade of a board: its hardest technique, and the steps of every technique it used.
+ */
+void printBoardGrade(struct boardGrade *grade);
+
+/*
+ * This function prints that boards longer than maxLen can not be graded.
+ */
+void printGradeTooLong(int maxLen);
+
+/*
+ * This function prints that name is not the name of a grade.
+ */
+void printUnknownGrade(char *name);
+
+/*
+ * This function prints that none of the attempts boards generate_graded made was of the grade named name.
+ */
+void printGradeNotGenerated(char *name, int attempts);
+
 /*
  * This function prints the amount of possible solutions of the board,
  * returned by "numSolutions".
@@ -211,12 +278,92 @@ void printBoardIsFull();
  */
 void printValuesAndScores(int row, int col, int *cellValues, double *scores, int length);
 
+/*
+ * This function prints the possible values and their scores for every cell of an N*N board,
+ * calculated by "guessHintAll". The values of cell <row, col> are values[starts[cell]..starts[cell + 1] - 1],
+ * where cell = row * N + col, and cells with no values are left out.
+ */
+void printScoreTable(int N, int *values, double *scores, int *starts);
+
 /*
  * This function prints the hint for the cell, as the user requested.
  * The format of cell print is <col, row>, similar to "set".
  */
 void printHint(int row, int col, int hint);
 
+/* SOLVER BACKEND RELATED */
+
+/*
+ * This function prints that the solver backend is now backendName.
+ */
+void printBackendSelected(char *backendName);
+
+/*
+ * This function prints that there is no solver backend named backendName.
+ */
+void printUnknownBackend(char *backendName);
+
+/*
+ * This function prints that the solver backend backendName is not included in this build.
+ */
+void printBackendNotBuilt(char *backendName);
+
+/* BUDGET RELATED */
+
+/*
+ * This function prints that the solver ran out of the budget of the command before it finished.
+ */
+void printBudgetExhausted();
+
+/*
+ * This function prints that there is no budget named kindName.
+ */
+void printUnknownBudget(char *kindName);
+
+/*
+ * This function prints the limit every command now has on the budget named kindName, in unit.
+ * A limit of 0 means there is no limit.
+ */
+void printBudgetSet(char *kindName, double limit, char *unit);
+
+/* SOLVER STATISTICS RELATED */
+
+/*
+ * This function prints the totals of the solver named name, and its last call.
+ */
+void printSolverTotals(char *name, struct solverTotals *totals);
+
+/*
+ * This function prints that no solver was called yet.
+ */
+void printNoSolverCalls();
+
+/*
+ * This function prints the races the race backend ran over m*n boards of which
+ * the given quarter of the cells is filled, and how many each side won.
+ */
+void printRaceRecord(int m, int n, int filledQuarter, long gurobiWins, long nativeWins);
+
+/*
+ * This function prints where the solver log and the model export are written, if anywhere.
+ */
+void printSolverOutputs(char *logPath, char *exportPath);
+
+/*
+ * This function prints that the file at path could not be opened for the solver log.
+ */
+void printSolverLogFailed(char *path);
+
+/*
+ * This function prints that the path given for the model export is too long.
+ */
+void printModelExportTooLong();
+
+/*
+ * This function prints that option is not an option of the solver_stats command.
+ */
+void printUnknownSolverStatsOption(char *option);
+
 /* FILES RELATED */
 
 /*
@@ -0,0 +1,307 @@
+/*
+ * This module is a built-in LP relaxation solver for guess and guess_hint, which needs no external library.
+ * It relaxes the board like the Gurobi LP: every legal value of every empty cell gets a score in [0, 1],
+ * and the scores of every empty cell, and of every row/column/block and value missing from it, sum up to 1.
+ * It implements the same contracts as guessCellValues and guessSolution in gurobi.h.
+ *
+ * Instead of a vertex of the relaxation, it finds its point of maximal entropy, by scaling the scores
+ * of one constraint at a time to sum up to 1 (Sinkhorn scaling, over the four constraint families
+ * of the board). Every sweep over the constraints costs as much as the open candidates.
+ * Values which are in no solution of the relaxation fade towards 0, and the others keep
+ * scores that tell how free they are.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "native_lp.h"
+#include "lp_relaxation.h"
+#include "util/board_manager.h"
+#include "util/candidate_index.h"
+#include "native_solver.h"
+#include "util/budget.h"
+#include "util/solver_stats.h"
+
+#define MAX_LP_ROUNDS 10
+#define LP_SWEEPS_PER_ROUND 100
+#define LP_TOLERANCE 1e-9 /* the sweeps stop once no constraint is further than this from 1 */
+#define LP_PRUNE_SCORE 1e-2 /* scores below this may be values which are in no solution */
+#define LP_ZERO_SCORE 1e-3 /* scores below this are left out of the relaxation */
+
+/*
+ * The last relaxation solved, which is reused while the board does not change.
+ */
+struct nativeLP {
+    struct relaxationKey key; /* the board which was relaxed, and the result of the solve */
+    struct candidateIndex index;
+    int *unitPos; /* the members of every unit and value, as positions in index.cellValues */
+    double *scores;
+};
+
+static struct nativeLP lastLP;
+
+/*
+ * This function frees the last relaxation the native LP keeps for reuse.
+ */
+void freeNativeLP(){
+    freeRelaxationKey(&(lastLP.key));
+    freeCandidateIndex(&(lastLP.index));
+    free(lastLP.unitPos);
+    free(lastLP.scores);
+    lastLP.unitPos = NULL;
+    lastLP.scores = NULL;
+}
+
+/*
+ * This function prepares lastLP for the board seen through view, of which the hash is hash:
+ * its key, its candidate index, the positions of the members of every unit and value,
+ * and a score of 1 for every candidate.
+ * Return values:
+ * -2: memory allocation failed.
+ *  0: lastLP is ready to be solved.
+ */
+int initNativeLP(struct boardView *view, unsigned long hash){
+    int row, col, i, count, *values, *next, N = viewLen(view), numKeys = NUM_UNIT_TYPES * N * N;
+    int block, pos = 0;
+
+    freeNativeLP();
+    if ((setRelaxationKey(&(lastLP.key), view, hash) == -2) || (initCandidateIndex(&(lastLP.index), view) == -1)){
+        freeRelaxationKey(&(lastLP.key));
+        return -2;
+    }
+    lastLP.unitPos = (int *)malloc((NUM_UNIT_TYPES * lastLP.index.numCandidates + 1) * sizeof(int));
+    lastLP.scores = (double *)malloc((lastLP.index.numCandidates + 1) * sizeof(double));
+    next = (int *)malloc(numKeys * sizeof(int));
+    if ((lastLP.unitPos == NULL) || (lastLP.scores == NULL) || (next == NULL)){
+        free(next);
+        freeNativeLP();
+        return -2;
+    }
+
+    /* the unit lists of the index are in the order of the candidates, so a cursor per key is enough */
+    for (i = 0; i < numKeys; i++){
+        next[i] = lastLP.index.unitStart[i];
+    }
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            block = blockNum(view->m, view->n, row, col);
+            values = cellCandidates(&(lastLP.index), row, col, &count);
+            for (i = 0; i < count; i++){
+                lastLP.unitPos[next[unitKey(N, rowUnit, row, values[i])]++] = pos;
+                lastLP.unitPos[next[unitKey(N, colUnit, col, values[i])]++] = pos;
+                lastLP.unitPos[next[unitKey(N, blockUnit, block, values[i])]++] = pos;
+                lastLP.scores[pos++] = 1;
+            }
+        }
+    }
+    free(next);
+    return 0;
+}
+
+/*
+ * This method scales the scores of the members of one constraint, so they sum up to 1.
+ * The members are scores[first..first + count - 1], or scores[pos[0..count - 1]] if pos != NULL.
+ * It returns how far their sum was from 1, or -1 if none of them is left to scale.
+ */
+double scaleConstraint(double *scores, int *pos, int first, int count){
+    int i;
+    double sum = 0;
+    for (i = 0; i < count; i++){
+        sum += scores[(pos == NULL) ? first + i : pos[i]];
+    }
+    if (sum <= 0){
+        return -1;
+    }
+    for (i = 0; i < count; i++){
+        scores[(pos == NULL) ? first + i : pos[i]] /= sum;
+    }
+    return (sum > 1) ? sum - 1 : 1 - sum;
+}
+
+/*
+ * This function sweeps over all the constraints of lastLP, scaling each of them in scores,
+ * until none is further than LP_TOLERANCE from 1 or maxSweeps sweeps were made.
+ * Every sweep is charged to the budget of the command as an iteration.
+ * It returns the furthest a constraint was from 1 on the last sweep,
+ * or -1 if a constraint has no member left.
+ */
+double sweepNativeLP(double *scores, int maxSweeps){
+    int cell, key, sweep, N = lastLP.key.m * lastLP.key.n;
+    int *cellStart = lastLP.index.cellStart, *unitStart = lastLP.index.unitStart;
+    double gap, maxGap = 1;
+    for (sweep = 0; (sweep < maxSweeps) && (maxGap > LP_TOLERANCE); sweep++){
+        maxGap = 0;
+        chargeBudget(iterationBudget, 1);
+        for (cell = 0; cell < N * N; cell++){
+            if (lastLP.key.board[cell] == 0){
+                gap = scaleConstraint(scores, NULL, cellStart[cell], cellStart[cell + 1] - cellStart[cell]);
+                if (gap < 0){
+                    return -1;
+                }
+                maxGap = (gap > maxGap) ? gap : maxGap;
+            }
+        }
+        for (key = 0; key < NUM_UNIT_TYPES * N * N; key++){
+            if (!lastLP.index.unitFilled[key]){
+                gap = scaleConstraint(scores, lastLP.unitPos + unitStart[key], 0,
+                                      unitStart[key + 1] - unitStart[key]);
+                if (gap < 0){
+                    return -1;
+                }
+                maxGap = (gap > maxGap) ? gap : maxGap;
+            }
+        }
+    }
+    return maxGap;
+}
+
+/*
+ * This method returns how many constraints lastLP has: one for every empty cell,
+ * and one for every row/column/block and value missing from it.
+ */
+int countNativeLPConstraints(){
+    int i, count = 0, N = lastLP.key.m * lastLP.key.n;
+    for (i = 0; i < N * N; i++){
+        count += (lastLP.key.board[i] == 0);
+    }
+    for (i = 0; i < NUM_UNIT_TYPES * N * N; i++){
+        count += !lastLP.index.unitFilled[i];
+    }
+    return count;
+}
+
+/*
+ * This function solves the relaxation of the board seen through view, of which the hash is hash,
+ * into lastLP, like solveNativeLP, and adds the time it spent in every phase to call.
+ */
+int solveNativeLPRounds(struct boardView *view, unsigned long hash, struct solverCall *call){
+    int i, round, numCandidates, res;
+    double gap = 1, trialGap, *trial, since = monotonicSeconds();
+    if (initNativeLP(view, hash) == -2){
+        return -2;
+    }
+    endSolverPhase(call, indexPhase, since);
+    since = monotonicSeconds();
+    numCandidates = lastLP.index.numCandidates;
+    call->numVars = numCandidates;
+    call->numConstrs = countNativeLPConstraints();
+    trial = (double *)malloc((numCandidates + 1) * sizeof(double));
+    if (trial == NULL){
+        freeNativeLP();
+        return -2;
+    }
+    for (round = 0; round < MAX_LP_ROUNDS; round++){
+        if (budgetExhausted()){ /* nothing is kept, the next call starts over */
+            free(trial);
+            freeNativeLP();
+            return -4;
+        }
+        gap = sweepNativeLP(lastLP.scores, LP_SWEEPS_PER_ROUND);
+        if ((gap < 0) || (gap <= LP_TOLERANCE)){ /* a constraint has no legal option, or the scores fit */
+            break;
+        }
+        for (i = 0; i < numCandidates; i++){
+            trial[i] = (lastLP.scores[i] < LP_PRUNE_SCORE) ? 0 : lastLP.scores[i];
+        }
+        trialGap = sweepNativeLP(trial, LP_SWEEPS_PER_ROUND);
+        if ((trialGap >= 0) && (trialGap <= LP_TOLERANCE)){
+            memcpy(lastLP.scores, trial, numCandidates * sizeof(double));
+            gap = trialGap;
+            break;
+        }
+    }
+    free(trial);
+    if ((gap >= 0) && (gap > LP_TOLERANCE)){
+        /* the scaling did not converge, which a board with a solution only on the boundary
+         * of its relaxation may do as well as an invalid one, so the search settles it */
+        res = solveBoardNative(view, NULL);
+        if (res < 0){
+            freeNativeLP();
+            return res;
+        }
+        lastLP.key.solved = res;
+    }
+    else {
+        lastLP.key.solved = (gap >= 0);
+    }
+    for (i = 0; i < numCandidates; i++){
+        if (lastLP.scores[i] < LP_ZERO_SCORE){
+            lastLP.scores[i] = 0;
+        }
+    }
+    endSolverPhase(call, optimizePhase, since);
+    return lastLP.key.solved;
+}
+
+/*
+ * This function solves the relaxation of the board seen through view into lastLP.
+ * The relaxation is solved again only if the board changed since the last call, as lastLP.key tells.
+ * Scaling alone reaches the values which are in no solution only slowly, so after every round
+ * of sweeps it tries to drop the values which faded below LP_PRUNE_SCORE: if the rest can still
+ * be scaled to fit every constraint, the scores of the rest are the relaxation.
+ * A board with a constraint which has no candidate left is invalid. If the scores still do not fit
+ * after all rounds, the native search tells whether the board is valid, and if so the scores are kept.
+ * The call is recorded in the solver statistics.
+ * Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ *  0: the board is invalid.
+ *  1: lastLP.scores holds the relaxation of the board.
+ */
+int solveNativeLP(struct boardView *view){
+    struct solverCall call;
+    int res;
+    unsigned long hash = viewHash(view);
+    if (matchRelaxationKey(&(lastLP.key), view, hash)){
+        recordCachedSolverCall(nativeLPSolver);
+        return lastLP.key.solved;
+    }
+    startSolverCall(&call, nativeLPSolver, view->m, view->n);
+    res = solveNativeLPRounds(view, hash, &call);
+    recordSolverCall(&call, res);
+    return res;
+}
+
+/*
+ * This function solves the board seen through view using the native LP.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ *  0: the board is invalid.
+ *  1: cell <row, col> values were successfully guessed.
+ *  It returns all the possible values of cell <row, col> through *pCellValues and their scores through *pScores.
+ * The length of *pCellValues and *pScores is returned through *pLength.
+ * User needs to free *pCellValues and *pScores iff return value == 1.
+ */
+int guessCellValuesNative(struct boardView *view, int row, int col,
+                          int **pCellValues, double **pScores, int *pLength){
+    struct lpRelaxation lp;
+    int res = solveNativeLP(view);
+    if (res != 1){
+        return res;
+    }
+    lp.index = &(lastLP.index);
+    lp.scores = lastLP.scores;
+    return relaxationCellValues(&lp, row, col, pCellValues, pScores, pLength);
+}
+
+/*
+ * This function solves the board seen through view using the native LP.
+ * retBoard is a copy of the board seen through view.
+ * The relaxation is rounded samples times, and the rounding which filled the most cells is kept (see roundRelaxation).
+ * It fills retBoard with the solution guessed iff return value == 1.
+ * Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ *  0: the board is invalid.
+ *  1: the board was successfully guessed.
+ */
+int guessSolutionNative(struct boardView *view, float threshold, int samples, int *retBoard){
+    struct lpRelaxation lp;
+    int res = solveNativeLP(view);
+    if (res != 1){
+        return res;
+    }
+    lp.index = &(lastLP.index);
+    lp.scores = lastLP.scores;
+    return roundRelaxation(&lp, view, threshold, samples, retBoard);
+}
@@ -0,0 +1,45 @@
+/*
+ * This module is a built-in LP relaxation solver for guess and guess_hint, which needs no external library.
+ * It relaxes the board like the Gurobi LP: every legal value of every empty cell gets a score in [0, 1],
+ * and the scores of every empty cell, and of every row/column/block and value missing from it, sum up to 1.
+ * It implements the same contracts as guessCellValues and guessSolution in gurobi.h.
+ */
+
+#ifndef SOFTWAREPROJECTFINALPROJECT_NATIVE_LP_H
+#define SOFTWAREPROJECTFINALPROJECT_NATIVE_LP_H
+
+#include "util/board_view.h"
+
+/*
+ * This function solves the board seen through view using the native LP.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ *  0: the board is invalid.
+ *  1: cell <row, col> values were successfully guessed.
+ *  It returns all the possible values of cell <row, col> through *pCellValues and their scores through *pScores.
+ * The length of *pCellValues and *pScores is returned through *pLength.
+ * User needs to free *pCellValues and *pScores iff return value == 1.
+ */
+int guessCellValuesNative(struct boardView *view, int row, int col,
+                          int **pCellValues, double **pScores, int *pLength);
+
+/*
+ * This function solves the board seen through view using the native LP.
+ * retBoard is a copy of the board seen through view.
+ * The relaxation is rounded samples times, and the rounding which filled the most cells is kept (see roundRelaxation).
+ * It fills retBoard with the solution guessed iff return value == 1.
+ * Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ *  0: the board is invalid.
+ *  1: the board was successfully guessed.
+ */
+int guessSolutionNative(struct boardView *view, float threshold, int samples, int *retBoard);
+
+/*
+ * This function frees the last relaxation the native LP keeps for reuse.
+ */
+void freeNativeLP();
+
+#endif
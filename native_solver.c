@@ -0,0 +1,574 @@
+/*
+ * This module is a built-in exact sudoku solver, which needs no external library.
+ * It solves the board by constraint propagation combined with an exhaustive search:
+ * at every step it picks the cell, or the row/column/block and value, with the fewest
+ * remaining options, and tries each of them in turn.
+ * It implements the same contract as solveBoard in gurobi.h.
+ * A random search, which tries the options in a random order and restarts once it went on
+ * for too long, fills the board with a random solution for generate.
+ */
+
+#include <stdlib.h>
+#include <limits.h>
+#include "native_solver.h"
+#include "util/budget.h"
+#include "util/solver_stats.h"
+#include "util/random.h"
+
+#define WORD_BITS ((int)(CHAR_BIT * sizeof(unsigned long)))
+#define BUDGET_POLL_NODES 1024 /* the nodes are charged to the budget of the command in batches of this size */
+#define RANDOM_RESTART_NODES 1000 /* the nodes of the first random search beyond one per empty cell */
+
+enum branchType {
+    cellBranch = 0,
+    rowBranch = 1,
+    colBranch = 2,
+    blockBranch = 3
+};
+
+/*
+ * The state of a single native search.
+ * Values are kept 0-based inside the search (value v is stored as v + 1 in board).
+ * Each unit holds a bitset of the values already used in it.
+ */
+struct nativeSearch {
+    int m;
+    int n;
+    int N;
+    int words; /* words per bitset */
+    int *board; /* N*N, 0 for an empty cell */
+    int *blockOf; /* the block number of every cell */
+    unsigned long *rowUsed; /* N bitsets */
+    unsigned long *colUsed;
+    unsigned long *blockUsed;
+    int *empty; /* the empty cells, empty[0..depth-1] are filled by the search */
+    int *posOf; /* posOf[cell] is the position of an empty cell in empty */
+    int numEmpty;
+    int *rowCount; /* scratch: how many cells of a unit can still hold a value */
+    int *colCount;
+    int *blockCount;
+    int *solution; /* the first solution found, or NULL */
+    int solutions;
+    int limit; /* the search stops after this many solutions */
+    long nodes;
+    int *order; /* for a random search, the order of the options at every depth (N per depth), or NULL */
+    struct randomStream *random; /* the stream a random search draws its orders from */
+    long nodeLimit; /* the search restarts once it made this many nodes, unless nodeLimit == 0 */
+    int restarted; /* 1 if the search was stopped to restart */
+    volatile int *stop; /* the search stops once *stop is set, unless stop == NULL */
+    int stopped; /* 1 if the search was stopped through stop */
+    int exhausted; /* 1 if the search was stopped because the budget ran out */
+};
+
+/*
+ * This method returns 1 if value v (0-based) is in bitset set.
+ */
+int bitIsSet(unsigned long *set, int v){
+    return (int)((set[v / WORD_BITS] >> (v % WORD_BITS)) & 1UL);
+}
+
+/*
+ * This method adds or removes value v (0-based) from bitset set.
+ */
+void setBit(unsigned long *set, int v, int on){
+    if (on){
+        set[v / WORD_BITS] |= (1UL << (v % WORD_BITS));
+    }
+    else{
+        set[v / WORD_BITS] &= ~(1UL << (v % WORD_BITS));
+    }
+}
+
+/*
+ * This method returns 1 if value v (0-based) can be placed in cell.
+ */
+int isNativeCandidate(struct nativeSearch *s, int cell, int v){
+    int W = s->words;
+    return !(bitIsSet(s->rowUsed + (cell / s->N) * W, v) ||
+             bitIsSet(s->colUsed + (cell % s->N) * W, v) ||
+             bitIsSet(s->blockUsed + s->blockOf[cell] * W, v));
+}
+
+/*
+ * This method places value v (0-based) in cell if on == 1, and removes it if on == 0.
+ */
+void placeNativeValue(struct nativeSearch *s, int cell, int v, int on){
+    int W = s->words;
+    setBit(s->rowUsed + (cell / s->N) * W, v, on);
+    setBit(s->colUsed + (cell % s->N) * W, v, on);
+    setBit(s->blockUsed + s->blockOf[cell] * W, v, on);
+    s->board[cell] = on ? v + 1 : 0;
+}
+
+/*
+ * This method swaps positions i and j of the empty cells list.
+ */
+void swapEmpty(struct nativeSearch *s, int i, int j){
+    int tmp = s->empty[i];
+    s->empty[i] = s->empty[j];
+    s->empty[j] = tmp;
+    s->posOf[s->empty[i]] = i;
+    s->posOf[s->empty[j]] = j;
+}
+
+/*
+ * This method returns the index of the k'th cell (0 <= k < N) of unit number unit of the given type.
+ */
+int unitCell(struct nativeSearch *s, enum branchType type, int unit, int k){
+    int row, col;
+    if (type == rowBranch){
+        return unit * s->N + k;
+    }
+    if (type == colBranch){
+        return k * s->N + unit;
+    }
+    getFirstIndexInBlock(s->m, s->n, unit, &row, &col);
+    return (row + k / s->n) * s->N + col + k % s->n;
+}
+
+/*
+ * This function frees a native search and everything it allocated.
+ */
+void freeNativeSearch(struct nativeSearch *s){
+    free(s->board);
+    free(s->blockOf);
+    free(s->rowUsed);
+    free(s->colUsed);
+    free(s->blockUsed);
+    free(s->empty);
+    free(s->posOf);
+    free(s->rowCount);
+    free(s->colCount);
+    free(s->blockCount);
+    free(s->solution);
+    free(s->order);
+}
+
+/*
+ * This function initializes s with the board seen through view.
+ * Return values:
+ * -2: memory allocation failed.
+ *  0: the board already contains a value twice in some unit.
+ *  1: the search is ready.
+ * User needs to call freeNativeSearch iff return value != -2.
+ */
+int initNativeSearch(struct nativeSearch *s, struct boardView *view){
+    int row, col, cell, val, N = viewLen(view), area = N * N;
+    s->m = view->m;
+    s->n = view->n;
+    s->N = N;
+    s->words = (N + WORD_BITS - 1) / WORD_BITS;
+    s->numEmpty = 0;
+    s->solutions = 0;
+    s->limit = 1;
+    s->nodes = 0;
+    s->order = NULL;
+    s->nodeLimit = 0;
+    s->restarted = 0;
+    s->stop = NULL;
+    s->stopped = 0;
+    s->exhausted = 0;
+    s->solution = NULL;
+    s->board = (int *)calloc(area, sizeof(int));
+    s->blockOf = (int *)malloc(area * sizeof(int));
+    s->rowUsed = (unsigned long *)calloc(N * s->words, sizeof(unsigned long));
+    s->colUsed = (unsigned long *)calloc(N * s->words, sizeof(unsigned long));
+    s->blockUsed = (unsigned long *)calloc(N * s->words, sizeof(unsigned long));
+    s->empty = (int *)malloc(area * sizeof(int));
+    s->posOf = (int *)malloc(area * sizeof(int));
+    s->rowCount = (int *)malloc(area * sizeof(int));
+    s->colCount = (int *)malloc(area * sizeof(int));
+    s->blockCount = (int *)malloc(area * sizeof(int));
+    if ((s->board == NULL) || (s->blockOf == NULL) || (s->rowUsed == NULL) || (s->colUsed == NULL)
+        || (s->blockUsed == NULL) || (s->empty == NULL) || (s->posOf == NULL)
+        || (s->rowCount == NULL) || (s->colCount == NULL) || (s->blockCount == NULL)){
+        freeNativeSearch(s);
+        return -2;
+    }
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            cell = row * N + col;
+            s->blockOf[cell] = blockNum(s->m, s->n, row, col);
+            val = viewCell(view, row, col);
+            if (val == 0){
+                s->posOf[cell] = s->numEmpty;
+                s->empty[s->numEmpty++] = cell;
+                continue;
+            }
+            if (!isNativeCandidate(s, cell, val - 1)){ /* val appears twice in a unit */
+                return 0;
+            }
+            placeNativeValue(s, cell, val - 1, 1);
+        }
+    }
+    return 1;
+}
+
+/*
+ * This function counts, for every open cell and every unit and value, how many options are left,
+ * and chooses the constraint with the fewest options to branch on.
+ * A cell is returned through *pUnit with *pType == cellBranch,
+ * a unit and value through *pType, *pUnit and *pValue.
+ * It returns 0 if some cell or unit has no option left, and 1 otherwise.
+ */
+int chooseNativeBranch(struct nativeSearch *s, int depth, enum branchType *pType, int *pUnit, int *pValue){
+    int i, v, cell, count, best = s->N + 1, N = s->N, W = s->words;
+    for (i = 0; i < N * N; i++){
+        s->rowCount[i] = 0;
+        s->colCount[i] = 0;
+        s->blockCount[i] = 0;
+    }
+    for (i = depth; i < s->numEmpty; i++){
+        cell = s->empty[i];
+        count = 0;
+        for (v = 0; v < N; v++){
+            if (isNativeCandidate(s, cell, v)){
+                count++;
+                s->rowCount[(cell / N) * N + v]++;
+                s->colCount[(cell % N) * N + v]++;
+                s->blockCount[s->blockOf[cell] * N + v]++;
+            }
+        }
+        if (count == 0){ /* this cell has no legal value */
+            return 0;
+        }
+        if (count < best){
+            best = count;
+            *pType = cellBranch;
+            *pUnit = cell;
+        }
+    }
+    if (best == 1){ /* a naked single, nothing can beat it */
+        return 1;
+    }
+    for (i = 0; i < N; i++){
+        for (v = 0; v < N; v++){
+            if (!bitIsSet(s->rowUsed + i * W, v)){
+                count = s->rowCount[i * N + v];
+                if (count == 0){ /* v fits nowhere in row i */
+                    return 0;
+                }
+                if (count < best){
+                    best = count, *pType = rowBranch, *pUnit = i, *pValue = v;
+                }
+            }
+            if (!bitIsSet(s->colUsed + i * W, v)){
+                count = s->colCount[i * N + v];
+                if (count == 0){
+                    return 0;
+                }
+                if (count < best){
+                    best = count, *pType = colBranch, *pUnit = i, *pValue = v;
+                }
+            }
+            if (!bitIsSet(s->blockUsed + i * W, v)){
+                count = s->blockCount[i * N + v];
+                if (count == 0){
+                    return 0;
+                }
+                if (count < best){
+                    best = count, *pType = blockBranch, *pUnit = i, *pValue = v;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+/*
+ * This method records the current (full) board as a solution.
+ * Return values:
+ * -2: memory allocation failed.
+ *  0: the solution was recorded.
+ */
+int recordNativeSolution(struct nativeSearch *s){
+    int i;
+    s->solutions++;
+    if (s->solutions == 1){
+        s->solution = (int *)malloc(s->N * s->N * sizeof(int));
+        if (s->solution == NULL){
+            return -2;
+        }
+        for (i = 0; i < s->N * s->N; i++){
+            s->solution[i] = s->board[i];
+        }
+    }
+    return 0;
+}
+
+/*
+ * This method returns the i'th option to try at the given depth: i itself,
+ * or its place in a random order drawn for the depth if the search is random.
+ */
+int nativeOption(struct nativeSearch *s, int depth, int i){
+    return (s->order == NULL) ? i : s->order[depth * s->N + i];
+}
+
+/*
+ * This function draws a random order of the N options to try at the given depth of a random search.
+ */
+void shuffleNativeOptions(struct nativeSearch *s, int depth){
+    int i, j, tmp, *order = s->order + depth * s->N;
+    for (i = 0; i < s->N; i++){
+        order[i] = i;
+    }
+    for (i = s->N - 1; i > 0; i--){
+        j = randomBelow(s->random, i + 1);
+        tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+}
+
+/*
+ * This function tries value v (0-based) in the empty cell at position pos,
+ * and searches the rest of the board from depth + 1.
+ * Return values:
+ * -2: memory allocation failed.
+ *  0: the search should go on.
+ *  1: the search should stop.
+ */
+int tryNativeValue(struct nativeSearch *s, int depth, int pos, int v);
+
+/*
+ * This function searches for solutions of the board, where empty[0..depth-1] are already filled.
+ * Return values:
+ * -2: memory allocation failed.
+ *  0: the search should go on.
+ *  1: the search should stop (the solution limit was reached, it was asked to stop or to restart,
+ *     or the budget ran out).
+ */
+int nativeSearchRec(struct nativeSearch *s, int depth){
+    int i, k, v, cell, unit = 0, value = 0, res;
+    enum branchType type = cellBranch;
+
+    if (depth == s->numEmpty){ /* the board is full */
+        if (recordNativeSolution(s) == -2){
+            return -2;
+        }
+        return (s->solutions >= s->limit);
+    }
+    s->nodes++;
+    if ((s->stop != NULL) && *(s->stop)){
+        s->stopped = 1;
+        return 1;
+    }
+    if ((s->nodes % BUDGET_POLL_NODES) == 0){
+        chargeBudget(nodeBudget, BUDGET_POLL_NODES);
+        if (budgetExhausted()){
+            s->exhausted = 1;
+            return 1;
+        }
+    }
+    if ((s->nodeLimit != 0) && (s->nodes >= s->nodeLimit)){
+        s->restarted = 1;
+        return 1;
+    }
+    if (!chooseNativeBranch(s, depth, &type, &unit, &value)){ /* dead end */
+        return 0;
+    }
+    if (s->order != NULL){
+        shuffleNativeOptions(s, depth);
+    }
+    if (type == cellBranch){
+        for (i = 0; i < s->N; i++){
+            v = nativeOption(s, depth, i);
+            if (isNativeCandidate(s, unit, v)){
+                res = tryNativeValue(s, depth, s->posOf[unit], v);
+                if (res != 0){
+                    return res;
+                }
+            }
+        }
+        return 0;
+    }
+    for (i = 0; i < s->N; i++){ /* every cell of the unit that can hold value */
+        k = nativeOption(s, depth, i);
+        cell = unitCell(s, type, unit, k);
+        if ((s->board[cell] == 0) && isNativeCandidate(s, cell, value)){
+            res = tryNativeValue(s, depth, s->posOf[cell], value);
+            if (res != 0){
+                return res;
+            }
+        }
+    }
+    return 0;
+}
+
+int tryNativeValue(struct nativeSearch *s, int depth, int pos, int v){
+    int res, cell = s->empty[pos];
+    swapEmpty(s, depth, pos);
+    placeNativeValue(s, cell, v, 1);
+    res = nativeSearchRec(s, depth + 1);
+    placeNativeValue(s, cell, v, 0);
+    swapEmpty(s, depth, pos);
+    return res;
+}
+
+/*
+ * This method solves the board seen through view using the native search, like solveBoardNativeUntil,
+ * but stops only once it found limit solutions, and adds the time it spent in every phase to call.
+ * Unless it fails like solveBoardNativeUntil, it returns the number of solutions it found.
+ */
+int solveNativeSearch(struct boardView *view, int *retBoard, int limit, volatile int *stop, struct solverCall *call){
+    struct nativeSearch s;
+    int i, res;
+    double since = monotonicSeconds();
+
+    res = initNativeSearch(&s, view);
+    if (res != 1){
+        if (res == 0){
+            freeNativeSearch(&s);
+        }
+        return res;
+    }
+    call->numVars = s.numEmpty;
+    endSolverPhase(call, modelPhase, since);
+    since = monotonicSeconds();
+    s.limit = limit;
+    s.stop = stop;
+    res = nativeSearchRec(&s, 0);
+    endSolverPhase(call, optimizePhase, since);
+    if (res == -2){
+        freeNativeSearch(&s);
+        return -2;
+    }
+    chargeBudget(nodeBudget, s.nodes % BUDGET_POLL_NODES);
+    if (s.stopped || s.exhausted){
+        freeNativeSearch(&s);
+        return s.stopped ? -3 : -4;
+    }
+    res = s.solutions;
+    if ((res > 0) && (retBoard != NULL)){
+        for (i = 0; i < s.N * s.N; i++){
+            retBoard[i] = s.solution[i];
+        }
+    }
+    freeNativeSearch(&s);
+    return res;
+}
+
+/*
+ * This method solves the board seen through view using the native search, like solveBoardNative,
+ * but gives up once *stop is set by another thread (unless stop == NULL).
+ * The call is recorded in the solver statistics.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -3: the search was stopped.
+ * -2: memory allocation failed.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoard is filled with a solution.
+ */
+int solveBoardNativeUntil(struct boardView *view, int *retBoard, volatile int *stop){
+    struct solverCall call;
+    int res;
+    startSolverCall(&call, nativeSearchSolver, view->m, view->n);
+    res = solveNativeSearch(view, retBoard, 1, stop, &call);
+    recordSolverCall(&call, res);
+    return res;
+}
+
+/*
+ * This method solves the board seen through view using the native search.
+ * The solution is returned through retBoard, unless retBoard == NULL.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoard is filled with a solution.
+ */
+int solveBoardNative(struct boardView *view, int *retBoard){
+    return solveBoardNativeUntil(view, retBoard, NULL);
+}
+
+/*
+ * This method counts the solutions of the board seen through view using the native search,
+ * stopping once it found limit of them, so telling one solution from several costs
+ * little more than finding one.
+ * The call is recorded in the solver statistics.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ * Otherwise, the number of solutions, up to limit.
+ */
+int countSolutionsNative(struct boardView *view, int limit){
+    struct solverCall call;
+    int res;
+    startSolverCall(&call, nativeSearchSolver, view->m, view->n);
+    res = solveNativeSearch(view, NULL, limit, NULL, &call);
+    recordSolverCall(&call, res);
+    return res;
+}
+
+/*
+ * This method fills the board seen through view with a random solution using a random native search,
+ * like fillBoardNativeRandom, and adds the time it spent in every phase to call.
+ */
+int fillNativeRandom(struct boardView *view, struct randomStream *random, int *retBoard, struct solverCall *call){
+    struct nativeSearch s;
+    int i, res;
+    long limit;
+    double since = monotonicSeconds();
+
+    res = initNativeSearch(&s, view);
+    if (res != 1){
+        if (res == 0){
+            freeNativeSearch(&s);
+        }
+        return res;
+    }
+    call->numVars = s.numEmpty;
+    limit = s.numEmpty + RANDOM_RESTART_NODES; /* every restart doubles it */
+    s.random = random;
+    s.order = (int *)malloc((s.numEmpty * s.N + 1) * sizeof(int));
+    if (s.order == NULL){
+        freeNativeSearch(&s);
+        return -2;
+    }
+    endSolverPhase(call, modelPhase, since);
+    since = monotonicSeconds();
+    do{ /* a search which went on for too long is likely stuck under a bad early choice */
+        s.restarted = 0;
+        s.nodeLimit = s.nodes + limit;
+        limit *= 2;
+        res = nativeSearchRec(&s, 0);
+    } while ((res == 1) && s.restarted);
+    endSolverPhase(call, optimizePhase, since);
+    if (res == -2){
+        freeNativeSearch(&s);
+        return -2;
+    }
+    chargeBudget(nodeBudget, s.nodes % BUDGET_POLL_NODES);
+    if (s.exhausted){
+        freeNativeSearch(&s);
+        return -4;
+    }
+    res = (s.solutions > 0);
+    if (res){
+        for (i = 0; i < s.N * s.N; i++){
+            retBoard[i] = s.solution[i];
+        }
+    }
+    freeNativeSearch(&s);
+    return res;
+}
+
+/*
+ * This method fills the board seen through view with a random solution, using a native search which
+ * tries the values and cells in an order drawn from random, and restarts with twice as many nodes
+ * whenever it goes on for too long. The cells filled in view are kept.
+ * The call is recorded in the solver statistics.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ *  0: the board has no solution.
+ *  1: retBoard is filled with a random solution.
+ */
+int fillBoardNativeRandom(struct boardView *view, struct randomStream *random, int *retBoard){
+    struct solverCall call;
+    int res;
+    startSolverCall(&call, nativeSearchSolver, view->m, view->n);
+    res = fillNativeRandom(view, random, retBoard, &call);
+    recordSolverCall(&call, res);
+    return res;
+}
@@ -0,0 +1,62 @@
+/*
+ * This module is a built-in exact sudoku solver, which needs no external library.
+ * It solves the board by constraint propagation combined with an exhaustive search:
+ * at every step it picks the cell, or the row/column/block and value, with the fewest
+ * remaining options, and tries each of them in turn.
+ * It implements the same contract as solveBoard in gurobi.h.
+ * A random search, which tries the options in a random order and restarts once it went on
+ * for too long, fills the board with a random solution for generate.
+ */
+
+#ifndef SOFTWAREPROJECTFINALPROJECT_NATIVE_SOLVER_H
+#define SOFTWAREPROJECTFINALPROJECT_NATIVE_SOLVER_H
+
+#include "util/board_view.h"
+#include "util/random.h"
+
+/*
+ * This method solves the board seen through view using the native search.
+ * The solution is returned through retBoard, unless retBoard == NULL.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoard is filled with a solution.
+ */
+int solveBoardNative(struct boardView *view, int *retBoard);
+
+/*
+ * This method solves the board seen through view using the native search, like solveBoardNative,
+ * but gives up once *stop is set by another thread (unless stop == NULL).
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -3: the search was stopped.
+ * -2: memory allocation failed.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoard is filled with a solution.
+ */
+int solveBoardNativeUntil(struct boardView *view, int *retBoard, volatile int *stop);
+
+/*
+ * This method counts the solutions of the board seen through view using the native search,
+ * stopping once it found limit of them.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ * Otherwise, the number of solutions, up to limit.
+ */
+int countSolutionsNative(struct boardView *view, int limit);
+
+/*
+ * This method fills the board seen through view with a random solution, using a native search which
+ * tries the values and cells in an order drawn from random, and restarts with twice as many nodes
+ * whenever it goes on for too long. The cells filled in view are kept.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ *  0: the board has no solution.
+ *  1: retBoard is filled with a random solution.
+ */
+int fillBoardNativeRandom(struct boardView *view, struct randomStream *random, int *retBoard);
+
+#endif
@@ -10,6 +10,7 @@
 #include <string.h>
 #include "game.h"
 #include "main_aux.h"
+#include "batch.h"
 #include "util/board_manager.h"
 
 /*
@@ -309,13 +310,16 @@ int interpretValidate(char *token, struct sudokuManager *board, enum Mode mode)
 /*
  * This method assumes the command entered is guess,
  * checks the validity of the rest of the command and executes it.
+ * The first parameter is the threshold, and the optional second one is the number of roundings to keep the best of.
  * Available only in Solve mode.
  * It returns 0 if we need to continue, and -1 if we need to terminate.
  */
 int interpretGuess(char *token, struct sudokuManager *board, enum Mode mode) {
     enum Mode availableModes[1] = {Solve};
-    int check;
+    int arrNumOfParams[2] = {1, 2};
+    int check, samples = 1;
     float input;
+    char *samplesToken;
 
     if (mode != Solve) {
         printUnavailableMode(6, mode, availableModes, 1);
@@ -328,8 +332,9 @@ int interpretGuess(char *token, struct sudokuManager *board, enum Mode mode) {
         return 0;
     }
     else{
-        if (strtok(NULL, " \t\r\n") != NULL){ /* too many parameters */
-            printExtraParams(1, 6);
+        samplesToken = strtok(NULL, " \t\r\n");
+        if ((samplesToken != NULL) && (strtok(NULL, " \t\r\n") != NULL)){ /* too many parameters */
+            printExtraParamsExtend(arrNumOfParams, 2, 6);
             return 0;
         }
         else{
@@ -349,9 +354,18 @@ int interpretGuess(char *token, struct sudokuManager *board, enum Mode mode) {
                     printf("The parameter should be a non-negative float between 0 and 1.\n");
                     return 0;
                 }
-                else{
-                    return guess(board, input);
+                if (samplesToken != NULL){
+                    if (!isAllDigits(samplesToken) || (sscanf(samplesToken, "%d", &samples) != 1)){
+                        printNotANumber(2);
+                        return 0;
+                    }
+                    if (samples <= 0){
+                        printWrongRangeInt(6, samples, 2);
+                        printf("The parameter should be a positive integer.\n");
+                        return 0;
+                    }
                 }
+                return guess(board, input, samples);
             }
         }
     }
@@ -421,6 +435,207 @@ int interpretGenerate(char *token, struct sudokuManager **pBoard, enum Mode mode
     }
 }
 
+/*
+ * This method assumes the command entered is generate_unique,
+ * checks the validity of the rest of the command and executes it.
+ * The first parameter is the number of cells to leave, and the optional second one is "minimal".
+ * Available only in Edit mode.
+ * It returns 0 if we need to continue, and -1 if we need to terminate.
+ */
+int interpretGenerateUnique(char *token, struct sudokuManager **pBoard, enum Mode mode) {
+    enum Mode availableModes[1] = {Edit};
+    int arrNumOfParams[2] = {1, 2};
+    char *option;
+    int Y;
+
+    if (mode != Edit) {
+        printUnavailableMode(21, mode, availableModes, 1);
+        return 0;
+    }
+    token = strtok(NULL, " \t\r\n");
+    if (token == NULL){ /* not enough parameters */
+        printFewParams(1, 21);
+        return 0;
+    }
+    option = strtok(NULL, " \t\r\n");
+    if ((option != NULL) && (strtok(NULL, " \t\r\n") != NULL)){ /* too many parameters */
+        printExtraParamsExtend(arrNumOfParams, 2, 21);
+        return 0;
+    }
+    if (!isAllDigits(token) || (sscanf(token, "%d", &Y) != 1)){
+        printNotANumber(1);
+        return 0;
+    }
+    if (Y < 0 || Y > boardArea(*pBoard)) {
+        printWrongRangeInt(21, Y, 1);
+        printRangeInt(0, boardArea(*pBoard), "non-negative");
+        return 0;
+    }
+    if ((option != NULL) && strcmp(option, "minimal")){
+        printUnknownGenerateUniqueOption(option);
+        return 0;
+    }
+    return generateUnique(pBoard, Y, option != NULL);
+}
+
+/*
+ * This method assumes the command entered is generate_graded,
+ * checks the validity of the rest of the command and executes it.
+ * The parameters are the number of cells to leave, the grade to generate (the name of the hardest technique),
+ * and optionally the number of boards to try, 1000 unless given.
+ * Available only in Edit mode.
+ * It returns 0 if we need to continue, and -1 if we need to terminate.
+ */
+int interpretGenerateGraded(char *token, struct sudokuManager **pBoard, enum Mode mode) {
+    enum Mode availableModes[1] = {Edit};
+    int arrNumOfParams[2] = {2, 3};
+    char *params[3];
+    int numParams = 0, Y, target, attempts = 1000;
+
+    if (mode != Edit) {
+        printUnavailableMode(25, mode, availableModes, 1);
+        return 0;
+    }
+    while ((token = strtok(NULL, " \t\r\n")) != NULL){
+        if (numParams == 3){ /* too many parameters */
+            printExtraParamsExtend(arrNumOfParams, 2, 25);
+            return 0;
+        }
+        params[numParams++] = token;
+    }
+    if (numParams < 2){ /* not enough parameters */
+        printFewParams(2, 25);
+        return 0;
+    }
+    if (!isAllDigits(params[0]) || (sscanf(params[0], "%d", &Y) != 1)){
+        printNotANumber(1);
+        return 0;
+    }
+    if (Y < 0 || Y > boardArea(*pBoard)) {
+        printWrongRangeInt(25, Y, 1);
+        printRangeInt(0, boardArea(*pBoard), "non-negative");
+        return 0;
+    }
+    target = gradeTechniqueByName(params[1]);
+    if (target == -1){
+        printUnknownGrade(params[1]);
+        return 0;
+    }
+    if (numParams == 3){
+        if (!isAllDigits(params[2]) || (sscanf(params[2], "%d", &attempts) != 1)){
+            printNotANumber(3);
+            return 0;
+        }
+        if (attempts <= 0){
+            printWrongRangeInt(25, attempts, 3);
+            printf("The parameter should be a positive integer.\n");
+            return 0;
+        }
+    }
+    return generateGraded(pBoard, Y, (enum gradeTechnique)target, attempts);
+}
+
+/*
+ * This method assumes the command entered is grade,
+ * checks the validity of the rest of the command and executes it.
+ * Available in Solve and Edit modes.
+ * It returns 0 if we need to continue, and -1 if we need to terminate.
+ */
+int interpretGrade(char *token, struct sudokuManager *board, enum Mode mode) {
+    enum Mode availableModes[2] = {Solve, Edit};
+    if (interpretNoArguments(token, mode, 24, availableModes, 2) == -1){
+        return 0;
+    }
+    else{
+        return grade(board);
+    }
+}
+
+/*
+ * This method assumes the command entered is seed,
+ * checks the validity of the rest of the command and executes it.
+ * With no parameters it prints the seed of the session, and with a non-negative integer it seeds the session.
+ * Available in every mode.
+ * It returns 0.
+ */
+int interpretSeed(char *token){
+    unsigned long seed = 0;
+    int arrNumOfParams[2] = {0, 1};
+
+    token = strtok(NULL, " \t\r\n");
+    if (token == NULL){
+        setSeed(0, seed);
+        return 0;
+    }
+    if (strtok(NULL, " \t\r\n") != NULL){ /* too many parameters */
+        printExtraParamsExtend(arrNumOfParams, 2, 23);
+        return 0;
+    }
+    if (!isAllDigits(token) || (sscanf(token, "%lu", &seed) != 1)){
+        printNotANumber(1);
+        return 0;
+    }
+    setSeed(1, seed);
+    return 0;
+}
+
+/*
+ * This method assumes the command entered is generate_batch,
+ * checks the validity of the rest of the command and executes it.
+ * Its parameters are the number of boards, the m and n of their blocks, the cells to leave filled,
+ * the seed, the file or directory to write to, and optionally the number of threads (0 for one per processor).
+ * Available in every mode.
+ * It returns 0 if we need to continue, and -1 if we need to terminate.
+ */
+int interpretGenerateBatch(char *token) {
+    char *params[7];
+    int arrNumOfParams[2] = {6, 7};
+    int i, numParams = 0, arrInput[4], threads = 0, area;
+    unsigned long seed;
+
+    while ((token = strtok(NULL, " \t\r\n")) != NULL){
+        if (numParams == 7){ /* too many parameters */
+            printExtraParamsExtend(arrNumOfParams, 2, 22);
+            return 0;
+        }
+        params[numParams++] = token;
+    }
+    if (numParams < 6){ /* not enough parameters */
+        printFewParams(6, 22);
+        return 0;
+    }
+    for (i = 0; i < 4; i++){ /* the number of boards, m, n and the cells to leave filled */
+        if (!isAllDigits(params[i]) || (sscanf(params[i], "%d", &arrInput[i]) != 1)){
+            printNotANumber(i + 1);
+            return 0;
+        }
+        if ((i < 3) && (arrInput[i] <= 0)){
+            printWrongRangeInt(22, arrInput[i], i + 1);
+            printf("The parameter should be a positive integer.\n");
+            return 0;
+        }
+    }
+    if (arrInput[1] > BATCH_MAX_LEN / arrInput[2]){ /* m * n > BATCH_MAX_LEN, without overflowing */
+        printBatchTooLong(BATCH_MAX_LEN);
+        return 0;
+    }
+    area = arrInput[1] * arrInput[2] * arrInput[1] * arrInput[2];
+    if (arrInput[3] <= 0 || arrInput[3] > area){
+        printWrongRangeInt(22, arrInput[3], 4);
+        printRangeInt(1, area, "positive");
+        return 0;
+    }
+    if (!isAllDigits(params[4]) || (sscanf(params[4], "%lu", &seed) != 1)){
+        printNotANumber(5);
+        return 0;
+    }
+    if ((numParams == 7) && (!isAllDigits(params[6]) || (sscanf(params[6], "%d", &threads) != 1))){
+        printNotANumber(7);
+        return 0;
+    }
+    return generateBatchFiles(arrInput[0], arrInput[1], arrInput[2], arrInput[3], seed, params[5], threads);
+}
+
 /*
  * This method assumes the command entered is undo,
  * checks the validity of the rest of the command and executes it.
@@ -550,6 +765,22 @@ int interpretHintOrGuessHint(char *token, struct sudokuManager *board, int isHin
     }
 }
 
+/*
+ * This method assumes the command entered is guess_hint_all,
+ * checks the validity of the rest of the command and executes it.
+ * Available in Solve mode only.
+ * It returns 0 if we need to continue, and -1 if we need to terminate.
+ */
+int interpretGuessHintAll(char *token, struct sudokuManager *board, enum Mode mode) {
+    enum Mode availableModes[1] = {Solve};
+    if (interpretNoArguments(token, mode, 20, availableModes, 1) == -1){
+        return 0;
+    }
+    else{
+        return guessHintAll(board);
+    }
+}
+
 /*
  * This method assumes the command entered is num_solutions,
  * checks the validity of the rest of the command and executes it.
@@ -599,6 +830,41 @@ int interpretReset(char *token, struct sudokuManager *board, enum Mode mode) {
     }
 }
 
+/*
+ * This method assumes the command entered is goto_move,
+ * checks the validity of the rest of the command and executes it.
+ * Available in Solve and Edit modes.
+ * It returns 0.
+ */
+int interpretGoToMove(char *token, struct sudokuManager *board, enum Mode mode) {
+    enum Mode availableModes[2] = {Solve, Edit};
+    int move;
+    if (mode != Solve && mode != Edit) {
+        printUnavailableMode(26, mode, availableModes, 2);
+        return 0;
+    }
+    token = strtok(NULL, " \t\r\n");
+    if (token == NULL){
+        printFewParams(1, 26);
+        return 0;
+    }
+    if (strtok(NULL, " \t\r\n") != NULL){ /* too many parameters */
+        printExtraParams(1, 26);
+        return 0;
+    }
+    if (!isAllDigits(token) || (sscanf(token, "%d", &move) != 1)){
+        printNotANumber(1);
+        return 0;
+    }
+    if (move < 0 || move > board->movesList->numBatches){
+        printWrongRangeInt(26, move, 1);
+        printRangeInt(0, board->movesList->numBatches, "non-negative");
+        return 0;
+    }
+    goToMove(board, move);
+    return 0;
+}
+
 /*
  * This method assumes the command entered is exit,
  * checks the validity of the rest of the command and executes it.
@@ -615,6 +881,104 @@ int interpretExit(char *token, struct sudokuManager *board, enum Mode mode) {
     }
 }
 
+/*
+ * This method assumes the command entered is backend,
+ * checks the validity of the rest of the command and executes it.
+ * Available in every mode.
+ * It returns 0.
+ */
+int interpretBackend(char *token){
+    token = strtok(NULL, " \t\r\n");
+
+    if (token == NULL){ /* not enough parameters */
+        printFewParams(1, 17);
+        return 0;
+    }
+    if (strtok(NULL, " \t\r\n") != NULL){ /* too many parameters */
+        printExtraParams(1, 17);
+        return 0;
+    }
+    changeBackend(token);
+    return 0;
+}
+
+/*
+ * This method assumes the command entered is budget,
+ * checks the validity of the rest of the command and executes it.
+ * The time budget is a float of seconds, the nodes and iterations budgets are integers,
+ * and none of them may be negative (0 means there is no limit).
+ * Available in every mode.
+ * It returns 0.
+ */
+int interpretBudget(char *token){
+    char *value;
+    int isTime, check;
+    double limit;
+
+    token = strtok(NULL, " \t\r\n");
+    value = strtok(NULL, " \t\r\n");
+    if (value == NULL){ /* not enough parameters */
+        printFewParams(2, 18);
+        return 0;
+    }
+    if (strtok(NULL, " \t\r\n") != NULL){ /* too many parameters */
+        printExtraParams(2, 18);
+        return 0;
+    }
+    isTime = !strcmp(token, "time");
+    if (isTime ? !isAFloat(value) : !isAllDigits(value)){
+        if (isTime){
+            printNotAFloat(2);
+        }
+        else{
+            printNotANumber(2);
+        }
+        return 0;
+    }
+    check = sscanf(value, "%lf", &limit);
+    if (check != 1){ /* sanity check */
+        printNotANumber(2);
+        return 0;
+    }
+    if (limit < 0){
+        printWrongRangeFloat(18, (float)limit, 2);
+        printf("The parameter should be non-negative, or 0 for no limit.\n");
+        return 0;
+    }
+    setBudget(token, limit);
+    return 0;
+}
+
+/*
+ * This method assumes the command entered is solver_stats,
+ * checks the validity of the rest of the command and executes it.
+ * With no parameters it prints the solver statistics, and with "log" or "export" and a file
+ * (or "off") it sets where the solver log or the model export is written.
+ * Available in every mode.
+ * It returns 0.
+ */
+int interpretSolverStats(char *token){
+    char *path;
+    int arrNumOfParams[2] = {0, 2};
+
+    token = strtok(NULL, " \t\r\n");
+    if (token == NULL){
+        showSolverStats();
+        return 0;
+    }
+    path = strtok(NULL, " \t\r\n");
+    if (path == NULL){ /* not enough parameters */
+        printFewParams(2, 19);
+        return 0;
+    }
+    if (strtok(NULL, " \t\r\n") != NULL){ /* too many parameters */
+        printExtraParamsExtend(arrNumOfParams, 2, 19);
+        return 0;
+    }
+    setSolverOutput(token, path);
+    return 0;
+}
+
 /*
  * This function skips characters until we reach the next line or EOF.
  */
@@ -687,6 +1051,26 @@ int interpret(char *command, struct sudokuManager **pBoard, enum Mode mode){
                 return interpretReset(token, board, mode);
             case 16:
                 return interpretExit(token, board, mode);
+            case 17:
+                return interpretBackend(token);
+            case 18:
+                return interpretBudget(token);
+            case 19:
+                return interpretSolverStats(token);
+            case 20:
+                return interpretGuessHintAll(token, board, mode);
+            case 21:
+                return interpretGenerateUnique(token, pBoard, mode);
+            case 22:
+                return interpretGenerateBatch(token);
+            case 23:
+                return interpretSeed(token);
+            case 24:
+                return interpretGrade(token, board, mode);
+            case 25:
+                return interpretGenerateGraded(token, pBoard, mode);
+            case 26:
+                return interpretGoToMove(token, board, mode);
             default:
                 printInvalidCommand();
                 return 0;
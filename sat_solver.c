@@ -0,0 +1,207 @@
+/*
+ * This module is a built-in SAT solver backend, which needs no external library.
+ * It encodes the board as a formula in conjunctive normal form, with a variable for every cell and value:
+ * every cell holds at least one value and at most one, and so does every row/column/block with every value.
+ * The formula of an empty m*n board is solved by the CDCL solver of util/cdcl.h, under the filled cells
+ * as assumptions, and it is kept between calls with all it learnt, so solving boards of the same size
+ * again (as validate and hint do after every move) costs little.
+ * It implements the same contract as solveBoard in gurobi.h.
+ */
+
+#include <stdlib.h>
+#include "sat_solver.h"
+#include "util/cdcl.h"
+#include "util/candidate_index.h"
+#include "util/budget.h"
+#include "util/solver_stats.h"
+
+/*
+ * The formula of an empty formulaM*formulaN board, or none while formulaM == 0.
+ * Value v (0-based) of cell number cell (row * N + col) is variable cell * N + v.
+ */
+static struct cdclSolver formula;
+static int formulaM = 0;
+static int formulaN = 0;
+
+/*
+ * This function frees the formula the SAT solver keeps between calls.
+ */
+void freeSatFormula(){
+    if (formulaM != 0){
+        freeCdclSolver(&formula);
+        formulaM = formulaN = 0;
+    }
+}
+
+/*
+ * This method returns the number of the k'th cell (0 <= k < N) of unit number unit of the given type,
+ * on an m*n board.
+ */
+int satUnitCell(int m, int n, enum unitType type, int unit, int k){
+    int row, col, N = m * n;
+    if (type == rowUnit){
+        return unit * N + k;
+    }
+    if (type == colUnit){
+        return k * N + unit;
+    }
+    getFirstIndexInBlock(m, n, unit, &row, &col);
+    return (row + k / n) * N + col + k % n;
+}
+
+/*
+ * This function adds to the formula that exactly one of the N given literals is true:
+ * a clause for at least one, and a clause for every pair for at most one.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the clauses were added.
+ */
+int addExactlyOne(int *lits, int N){
+    int i, j, pair[2];
+    if (addCdclClause(&formula, lits, N) == -1){
+        return -1;
+    }
+    for (i = 0; i < N; i++){
+        for (j = i + 1; j < N; j++){
+            pair[0] = lits[i] ^ 1;
+            pair[1] = lits[j] ^ 1;
+            if (addCdclClause(&formula, pair, 2) == -1){
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * This function builds the formula of an empty m*n board, instead of the one kept so far.
+ * Return values:
+ * -2: memory allocation failed.
+ *  0: the formula was built.
+ */
+int buildSatFormula(int m, int n){
+    int cell, v, k, unit, type, N = m * n, *lits;
+    freeSatFormula();
+    lits = (int *)malloc(N * sizeof(int));
+    if (lits == NULL){
+        return -2;
+    }
+    if (initCdclSolver(&formula, N * N * N) == -1){
+        free(lits);
+        return -2;
+    }
+    for (cell = 0; cell < N * N; cell++){
+        for (v = 0; v < N; v++){
+            lits[v] = CDCL_LIT(cell * N + v, 1);
+        }
+        if (addExactlyOne(lits, N) == -1){
+            free(lits);
+            freeCdclSolver(&formula);
+            return -2;
+        }
+    }
+    for (type = 0; type < NUM_UNIT_TYPES; type++){
+        for (unit = 0; unit < N; unit++){
+            for (v = 0; v < N; v++){
+                for (k = 0; k < N; k++){
+                    lits[k] = CDCL_LIT(satUnitCell(m, n, (enum unitType)type, unit, k) * N + v, 1);
+                }
+                if (addExactlyOne(lits, N) == -1){
+                    free(lits);
+                    freeCdclSolver(&formula);
+                    return -2;
+                }
+            }
+        }
+    }
+    free(lits);
+    formulaM = m;
+    formulaN = n;
+    return 0;
+}
+
+/*
+ * This method solves the board seen through view using the SAT solver, like solveBoardSatUntil,
+ * and adds the time it spent in every phase to call.
+ */
+int solveSat(struct boardView *view, int *retBoard, volatile int *stop, struct solverCall *call){
+    int row, col, cell, v, res, numAssumptions = 0, N = viewLen(view), *assumptions;
+    double since = monotonicSeconds();
+
+    assumptions = (int *)malloc(N * N * sizeof(int));
+    if (assumptions == NULL){
+        return -2;
+    }
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            if (viewCell(view, row, col) != 0){
+                assumptions[numAssumptions++] = CDCL_LIT((row * N + col) * N + viewCell(view, row, col) - 1, 1);
+            }
+        }
+    }
+    endSolverPhase(call, indexPhase, since);
+    since = monotonicSeconds();
+    if ((formulaM != view->m) || (formulaN != view->n)){
+        if (buildSatFormula(view->m, view->n) == -2){
+            free(assumptions);
+            return -2;
+        }
+    }
+    call->numVars = formula.numVars;
+    call->numConstrs = formula.numClauses;
+    endSolverPhase(call, modelPhase, since);
+
+    since = monotonicSeconds();
+    res = solveCdcl(&formula, assumptions, numAssumptions, stop);
+    free(assumptions);
+    endSolverPhase(call, optimizePhase, since);
+    if (res == -1){ /* the formula was left half updated */
+        freeSatFormula();
+        return -2;
+    }
+    if ((res == 1) && (retBoard != NULL)){
+        since = monotonicSeconds();
+        for (cell = 0; cell < N * N; cell++){
+            for (v = 0; v < N; v++){
+                if (cdclValue(&formula, cell * N + v)){
+                    retBoard[cell] = v + 1;
+                }
+            }
+        }
+        endSolverPhase(call, decodePhase, since);
+    }
+    return res;
+}
+
+/*
+ * This method solves the board seen through view using the SAT solver, like solveBoardSat,
+ * but gives up once *stop is set by another thread (unless stop == NULL).
+ * The call is recorded in the solver statistics.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -3: the solve was stopped.
+ * -2: memory allocation failed.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoard is filled with a solution.
+ */
+int solveBoardSatUntil(struct boardView *view, int *retBoard, volatile int *stop){
+    struct solverCall call;
+    int res;
+    startSolverCall(&call, satSolver, view->m, view->n);
+    res = solveSat(view, retBoard, stop, &call);
+    recordSolverCall(&call, res);
+    return res;
+}
+
+/*
+ * This method solves the board seen through view using the SAT solver.
+ * The solution is returned through retBoard, unless retBoard == NULL.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoard is filled with a solution.
+ */
+int solveBoardSat(struct boardView *view, int *retBoard){
+    return solveBoardSatUntil(view, retBoard, NULL);
+}
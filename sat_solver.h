@@ -0,0 +1,44 @@
+/*
+ * This module is a built-in SAT solver backend, which needs no external library.
+ * It encodes the board as a formula in conjunctive normal form, with a variable for every cell and value:
+ * every cell holds at least one value and at most one, and so does every row/column/block with every value.
+ * The formula of an empty m*n board is solved by the CDCL solver of util/cdcl.h, under the filled cells
+ * as assumptions, and it is kept between calls with all it learnt, so solving boards of the same size
+ * again (as validate and hint do after every move) costs little.
+ * It implements the same contract as solveBoard in gurobi.h.
+ */
+
+#ifndef SOFTWAREPROJECTFINALPROJECT_SAT_SOLVER_H
+#define SOFTWAREPROJECTFINALPROJECT_SAT_SOLVER_H
+
+#include "util/board_view.h"
+
+/*
+ * This method solves the board seen through view using the SAT solver.
+ * The solution is returned through retBoard, unless retBoard == NULL.
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -2: memory allocation failed.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoard is filled with a solution.
+ */
+int solveBoardSat(struct boardView *view, int *retBoard);
+
+/*
+ * This method solves the board seen through view using the SAT solver, like solveBoardSat,
+ * but gives up once *stop is set by another thread (unless stop == NULL).
+ *  Return values:
+ * -4: the budget of the command ran out.
+ * -3: the solve was stopped.
+ * -2: memory allocation failed.
+ *  0: the board is invalid.
+ *  1: the board is valid, and retBoard is filled with a solution.
+ */
+int solveBoardSatUntil(struct boardView *view, int *retBoard, volatile int *stop);
+
+/*
+ * This function frees the formula the SAT solver keeps between calls.
+ */
+void freeSatFormula();
+
+#endif
@@ -1,7 +1,7 @@
 /*
  * This module handles everything that has to do with solving the board.
- * It communicates with game.c and gurobi.c. game.c tells this module what command it wants to be done,
- * and this module prepares everything needed to call functions from gurobi.c to solve the board, or validate it.
+ * It communicates with game.c and the solver backends (backend.c). game.c tells this module what command it wants
+ * to be done, and this module prepares everything needed to call the selected backend to solve the board, or validate it.
  * In addition, it contains everything regarding the backtracking algorithm used to count the number of possible
  * solutions to the current board.
  */
@@ -10,55 +10,101 @@
 #include <stdlib.h>
 #include "solver.h"
 #include "util/board_manager.h"
+#include "util/board_view.h"
 #include "main_aux.h"
-#include "gurobi.h"
+#include "backend.h"
+#include "native_solver.h"
+#include "util/budget.h"
+#include "util/random.h"
 
-#define NUM_ITERATIONS 1000
+#define GENERATE_POOL_SIZE 50 /* the solutions generate asks for in a single solve */
+#define GENERATE_FILL_ATTEMPTS 10 /* the raffles of the X cells of generate before filling without them */
+#define BUDGET_POLL_NODES 1024 /* backtracking charges its nodes to the budget in batches of this many */
+
+/* WITNESS SOLUTION */
 
 /*
- * This function creates a helper manager for Gurobi purposes.
- * It is a copy of manager which we autofill before sending to Gurobi module.
- * User needs to free *newManager iff return value == 0.
+ * The last full solution any solver call found, which answers hints and validations
+ * for as long as it agrees with the board. It was last checked against board version witnessVersion.
  */
-int helperManager(struct sudokuManager **newManager, struct sudokuManager *manager){
-    int* erroneous = (int*)calloc(boardArea(manager), sizeof(int));
-    int* fixed = (int*)calloc(boardArea(manager), sizeof(int));
-    struct movesList *list = (struct movesList*) malloc(sizeof(struct movesList));
-    int *newBoard = calloc(boardArea(manager), sizeof(int));
-    int m = manager->m, n = manager->n;
-    *newManager = (struct sudokuManager*)malloc(sizeof(struct sudokuManager));
-
-    initNullBoard(*newManager); /* sets all pointers in board to NULL */
-
-    if((*newManager == NULL) || (newBoard == NULL) || (erroneous == NULL)
-       || (fixed == NULL) || (list == NULL) || (newBoard == NULL)){
-        free(*newManager);
-        free(newBoard);
-        free(erroneous);
-        free(list);
-        free(fixed);
-        free(newBoard);
-        return -1;
-    }
+static int *witness = NULL;
+static int witnessM = 0;
+static int witnessN = 0;
+static long witnessVersion = 0;
 
-    duplicateBoard(manager->board, newBoard, m, n);
+/* SOLUTION POOL */
 
-    /* INITIALIZES NEW SUDOKU MANAGER */
-    initBoardValues(*newManager, m, n, newBoard, erroneous, fixed, manager->emptyCells, list);
+/*
+ * Full solutions a backend with a solution pool found in a single solve, which generate draws from.
+ * poolSolutions holds poolCount boards of poolM*poolN blocks, of which the ones before poolNext were drawn.
+ */
+static int *poolSolutions = NULL;
+static int poolM = 0;
+static int poolN = 0;
+static int poolCount = 0;
+static int poolNext = 0;
 
-    if(updateAutofillValuesBoard(*newManager) == -1){ /* autofill values in the new manager */
-        freeBoard(*newManager);
-        return -1;
+/*
+ * This function keeps solution, a full solution which agrees with every filled cell of manager's board,
+ * as the witness. If it can not be kept, the witness is dropped.
+ */
+void keepWitness(struct sudokuManager *manager, int *solution){
+    int i;
+    if ((witness == NULL) || (witnessM != manager->m) || (witnessN != manager->n)){
+        free(witness);
+        witness = (int *)malloc(boardArea(manager) * sizeof(int));
+        if (witness == NULL){ /* the witness is only a shortcut, we can do without it */
+            return;
+        }
+        witnessM = manager->m;
+        witnessN = manager->n;
     }
-    return 0;
+    for (i = 0; i < boardArea(manager); i++){
+        witness[i] = solution[i];
+    }
+    witnessVersion = manager->version;
+}
+
+/*
+ * This function returns 1 if the witness is a solution of manager's board, and 0 otherwise.
+ * The cells are compared only if the board changed since the witness was last checked.
+ */
+int witnessAgrees(struct sudokuManager *manager){
+    int i;
+    if ((witness == NULL) || (witnessM != manager->m) || (witnessN != manager->n)){
+        return 0;
+    }
+    if (witnessVersion == manager->version){
+        return 1;
+    }
+    for (i = 0; i < boardArea(manager); i++){
+        if ((manager->board[i] != 0) && (manager->board[i] != witness[i])){ /* a conflicting set */
+            return 0;
+        }
+    }
+    witnessVersion = manager->version;
+    return 1;
+}
+
+/*
+ * This function frees the witness solution and the solution pool.
+ */
+void releaseSolverCache(){
+    free(witness);
+    witness = NULL;
+    free(poolSolutions);
+    poolSolutions = NULL;
+    poolCount = poolNext = 0;
 }
 
 /* VALIDATE */
 
 /*
  * This function validates a board using ILP.
+ * The board is not solved again if the witness solution still agrees with it.
  * Return values:
- * -2: Gurobi failure.
+ * -3: the budget of the command ran out.
+ * -2: solver backend failure.
  * -1: memory allocation failed.
  *  0: the board is invalid.
  *  1: the board is valid.
@@ -66,22 +112,36 @@ int helperManager(struct sudokuManager **newManager, struct sudokuManager *manag
 int validateBoard(struct sudokuManager *manager){
     int res;
     int *retBoard;
-    struct  sudokuManager *newManager;
+    struct boardView view;
 
-    if (helperManager(&newManager, manager) == -1){
+    if (witnessAgrees(manager)){
+        return 1;
+    }
+    if (initBoardView(&view, manager) == -1){
+        return -1;
+    }
+    retBoard = (int *)malloc(boardArea(manager) * sizeof(int));
+    if ((retBoard == NULL) || (autofillBoardView(&view) == -1)){
+        free(retBoard);
+        freeBoardView(&view);
         return -1;
     }
 
-    retBoard = newManager->board;
-
-    res = solveBoard(newManager, &retBoard); /* running Gurobi */
-    freeBoard(newManager);
-    if(res == -1){ /* Gurobi error */
+    res = backendSolveBoard(&view, retBoard); /* the solution is kept as the witness */
+    freeBoardView(&view);
+    if (res == 1){
+        keepWitness(manager, retBoard);
+    }
+    free(retBoard);
+    if(res == -1){ /* backend error */
         return -2;
     }
     if (res == -2) { /* memory allocation error */
         return -1;
     }
+    if (res == -4){ /* the budget ran out */
+        return -3;
+    }
     return res;
 }
 
@@ -91,145 +151,384 @@ int validateBoard(struct sudokuManager *manager){
  * This function guesses a solution for the entire board and
  * fills its cells with values with higher probability than [threshold]
  * to appear in a solution to the board.
+ * The LP is solved once and rounded samples times, and the rounding which filled the most cells is kept.
  * Return values:
- * -2: Gurobi failure.
+ * -3: the budget of the command ran out.
+ * -2: solver backend failure.
  * -1: memory allocation failed.
  *  0: The board is invalid.
  *  1: The board is valid and the guessed solution is filled in retBoard.
  */
-int doGuess(struct sudokuManager *manager, float threshold, int *retBoard){
+int doGuess(struct sudokuManager *manager, float threshold, int samples, int *retBoard){
     int res;
-    struct sudokuManager *newManager;
+    struct boardView view;
 
-    if (helperManager(&newManager, manager) == -1){ /* memory allocation failed */
+    if (initBoardView(&view, manager) == -1){ /* memory allocation failed */
         return -1;
     }
-    duplicateBoard(newManager->board, retBoard, manager->m, manager->n);
+    if (autofillBoardView(&view) == -1){
+        freeBoardView(&view);
+        return -1;
+    }
+    copyViewToBoard(&view, retBoard);
 
-    res = guessSolution(newManager, threshold, retBoard); /* running Gurobi */
+    res = backendGuessSolution(&view, threshold, samples, retBoard); /* running LP */
 
-    freeBoard(newManager);
+    freeBoardView(&view);
     if (res == -2){
         return -1;
     }
     if (res == -1){
         return -2;
     }
+    if (res == -4){
+        return -3;
+    }
     return res;
 }
 
 /* GENERATE */
 
 /*
- * This function raffles an integer between min an max.
+ * This function raffles an integer between min (included) and max (excluded), from the stream of the session.
  */
 int randRangeInt(int min, int max)
 {
-    int range = (max - min);
-    return min + (rand() % range);
+    return min + randomBelow(sessionRandom(), max - min);
 }
 
 /*
- * This function fills X random cells with legal values.
- * It returns 0 if there is no legal value for some index raffled.
- * If all raffled indices had legal values, it returns 1.
+ * This function empties cellsToRemove of the filled cells of retBoard, every choice of them equally likely.
+ * The filled cells are listed once, and a partial Fisher-Yates shuffle draws the cells to empty from the list,
+ * so emptying a cell takes a single draw however few filled cells are left.
+ * It returns -1 if memory allocation failed, and 0 otherwise.
  */
-int doGenerateFillNumRandomCells(struct sudokuManager *board, int *newBoard, int cellsToFill){
-    int row, col, val, m = board->m, n = board->n;
-    while (cellsToFill > 0) {
-        row = randRangeInt(0, boardLen(board));
-        col = randRangeInt(0, boardLen(board));
-        if (newBoard[matIndex(m, n, row, col)] == 0) { /* if cell is empty */
-            if (returnLegalValue(board->board, m, n, row, col) == -1){
-                return 0;
-            }
-            val = randRangeInt(0, boardLen(board)) + 1; /* randomizes a value between 1 and N */
-            while (neighbourContainsOnce(newBoard, m, n, row, col, val)) { /* as long as val is
-                                                                            * illegal for our curr cell */
-                val = randRangeInt(0, boardLen(board)) + 1; /* randomly choose different value  */
+int doGenerateRemoveNumRandomCells(struct sudokuManager *board, int *retBoard, int cellsToRemove){
+    int i, j, tmp, numFilled = 0, area = boardArea(board), *filled;
+    filled = (int *)malloc(area * sizeof(int));
+    if (filled == NULL){
+        return -1;
+    }
+    for (i = 0; i < area; i++){
+        if (retBoard[i] != 0){
+            filled[numFilled++] = i;
+        }
+    }
+    for (i = 0; (i < cellsToRemove) && (i < numFilled); i++){ /* the first i cells of filled are a uniform choice */
+        j = randRangeInt(i, numFilled);
+        tmp = filled[i];
+        filled[i] = filled[j];
+        filled[j] = tmp;
+        retBoard[filled[i]] = 0; /* empty it */
+    }
+    free(filled);
+    return 0;
+}
+
+/*
+ * This function fills cellsToFill random empty cells of view, one after the other,
+ * each with a value raffled among the values which are legal with the cells filled before it.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: a raffled cell had no legal value.
+ *  1: all raffled cells were filled.
+ */
+int doGenerateFillNumRandomCells(struct boardView *view, int cellsToFill){
+    int i, j, tmp, val, numEmpty = 0, numLegal, N = viewLen(view), *empty, *legal;
+    empty = (int *)malloc((N * N + N) * sizeof(int));
+    if (empty == NULL){
+        return -1;
+    }
+    legal = empty + N * N;
+    for (i = 0; i < N * N; i++){
+        if (viewCell(view, i / N, i % N) == 0){
+            empty[numEmpty++] = i;
+        }
+    }
+    for (i = 0; (i < cellsToFill) && (i < numEmpty); i++){ /* a partial Fisher-Yates shuffle of the empty cells */
+        j = randRangeInt(i, numEmpty);
+        tmp = empty[i];
+        empty[i] = empty[j];
+        empty[j] = tmp;
+        numLegal = 0;
+        for (val = 1; val <= N; val++){
+            if (!viewNeighbourContainsOnce(view, empty[i] / N, empty[i] % N, val)){
+                legal[numLegal++] = val;
             }
-            changeCellValue(newBoard, m, n, row, col, val); /* set the new value */
-            cellsToFill--; /* reduce X by one */
+        }
+        if (numLegal == 0){
+            free(empty);
+            return 0;
+        }
+        if (setViewCell(view, empty[i] / N, empty[i] % N, legal[randRangeInt(0, numLegal)]) == -1){
+            free(empty);
+            return -1;
         }
     }
+    free(empty);
     return 1;
 }
 
 /*
- * This function removes from retBoard cellsToRemove cells.
+ * This function generates a board like doGenerate, by raffling X cells and then filling the rest
+ * of the board with a random solution, which a random native search finds.
  */
-void doGenerateRemoveNumRandomCells(struct sudokuManager *board, int *retBoard, int cellsToRemove){
-    int row, col, m = board->m, n = board->n;
-    while (cellsToRemove > 0){
-        row = randRangeInt(0, boardLen(board));
-        col = randRangeInt(0, boardLen(board));
-        if(retBoard[matIndex(m, n, row, col)] != 0){ /* the cell is not empty */
-            changeCellValue(retBoard, m, n, row, col, 0); /* empty it */
-            cellsToRemove --;
+int generateByRandomFill(struct sudokuManager *board, int X, int Y, int *retBoard){
+    int attempt, res = 0;
+    struct boardView view;
+
+    if (initBoardView(&view, board) == -1){ /* memory allocation failed */
+        return -1;
+    }
+    for (attempt = 0; (X > 0) && (attempt < GENERATE_FILL_ATTEMPTS) && (res == 0); attempt++){
+        resetBoardView(&view); /* drop the cells raffled by the previous attempt */
+        res = doGenerateFillNumRandomCells(&view, X);
+        if (res == 1){
+            res = fillBoardNativeRandom(&view, sessionRandom(), retBoard);
+        }
+        else if (res == -1){
+            res = -2;
+        }
+    }
+    if (res == 0){ /* no raffle of the X cells had a solution, or X == 0 */
+        resetBoardView(&view);
+        res = fillBoardNativeRandom(&view, sessionRandom(), retBoard);
+    }
+    freeBoardView(&view);
+    if (res == -2){
+        return -1;
+    }
+    if (res == -4){ /* the budget ran out in the middle of the search */
+        return -3;
+    }
+    if (res == 1){
+        keepWitness(board, retBoard);
+        if (doGenerateRemoveNumRandomCells(board, retBoard, boardArea(board) - Y) == -1){
+            return -1;
         }
     }
+    return res;
 }
 
 /*
- * This function raffles X cells and fill it with legal values,
- * solves the board and leave Y cells out of the solution,
- * to generate a new board.
+ * This function copies to retBoard the next solution of the pool which agrees with every filled cell
+ * of manager's board, and drops the solutions before it.
+ * It returns 1 if there was such a solution, and 0 if the pool ran dry.
+ */
+int drawPoolSolution(struct sudokuManager *manager, int *retBoard){
+    int i, *solution, area = boardArea(manager);
+    if ((poolM != manager->m) || (poolN != manager->n)){
+        return 0;
+    }
+    while (poolNext < poolCount){
+        solution = poolSolutions + (poolNext++) * area;
+        for (i = 0; i < area; i++){
+            if ((manager->board[i] != 0) && (manager->board[i] != solution[i])){ /* a conflicting set */
+                break;
+            }
+        }
+        if (i == area){
+            for (i = 0; i < area; i++){
+                retBoard[i] = solution[i];
+            }
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * This function fills the pool with up to GENERATE_POOL_SIZE solutions of manager's board,
+ * found by the backend in a single solve.
+ * Return values are those of backendSolvePool.
+ */
+int refillSolutionPool(struct sudokuManager *manager){
+    int res, count, *solutions;
+    struct boardView view;
+
+    poolCount = poolNext = 0;
+    solutions = (int *)realloc(poolSolutions, GENERATE_POOL_SIZE * boardArea(manager) * sizeof(int));
+    if (solutions == NULL){
+        return -2;
+    }
+    poolSolutions = solutions;
+    poolM = manager->m;
+    poolN = manager->n;
+    if (initBoardView(&view, manager) == -1){
+        return -2;
+    }
+    if (autofillBoardView(&view) == -1){
+        freeBoardView(&view);
+        return -2;
+    }
+    res = backendSolvePool(&view, poolSolutions, GENERATE_POOL_SIZE, &count);
+    freeBoardView(&view);
+    if (res == 1){
+        poolCount = count;
+    }
+    return res;
+}
+
+/*
+ * This function fills X random empty cells of the board with legal values, fills the rest of it with
+ * a random solution, and leaves Y cells of it, to generate a new board.
+ * The solution is found by a random native search, which keeps the cells already filled. If the raffled
+ * cells leave no solution they are raffled again, up to GENERATE_FILL_ATTEMPTS times,
+ * and then the board is filled without them.
+ * If the backend has a solution pool, the solution is drawn instead from a pool of solutions
+ * found in a single solve, which later generates keep drawing from while its solutions agree
+ * with the board. The X cells would be filled from the drawn solution, so they are not raffled.
  * It updates the new board into *retBoard.
  * Return values:
+ * -3: the budget of the command ran out.
  * -1: memory allocation failed.
- *  0: generating board failed after many attempts.
+ *  0: the board has no solution.
  *  1: the board was successfully generated, and setted to *retBoard.
  */
 int doGenerate(struct sudokuManager *board, int X, int Y, int *retBoard){
-    /* ALL ALLOCATIONS */
-    int *newBoard, iter, retGurobi;
-    struct  sudokuManager *newManager;
-
-    if (helperManager(&newManager, board) == -1){ /* memory allocation failed */
+    int res;
+    if (!backendHasSolutionPool()){
+        return generateByRandomFill(board, X, Y, retBoard);
+    }
+    if (!drawPoolSolution(board, retBoard)){ /* the pool ran dry, a new solve is needed */
+        res = refillSolutionPool(board);
+        if (res == -2){
+            return -1;
+        }
+        if (res == -4){
+            return -3;
+        }
+        if (res == -1){ /* the backend failed to find a pool, the native search may still succeed */
+            return generateByRandomFill(board, X, Y, retBoard);
+        }
+        if ((res == 0) || !drawPoolSolution(board, retBoard)){ /* the board has no solution */
+            return 0;
+        }
+    }
+    keepWitness(board, retBoard);
+    if (doGenerateRemoveNumRandomCells(board, retBoard, boardArea(board) - Y) == -1){
         return -1;
     }
+    return 1;
+}
 
-    newBoard = newManager->board;
-
-    /* STARTING 1000 ITERETIONS */
-    for(iter = 0; iter < NUM_ITERATIONS; iter ++) {
-
-        duplicateBoard(board->board, newBoard, board->m, board->n); /* copy content of board->board to newBoard */
-
-        /* RANDOMLY FILLS X CELLS */
-        if (doGenerateFillNumRandomCells(board, newBoard, X) == 0) { /* this function fills random legal cells */
-            continue; /* if a raffled index had no illegal values, we need to try again */
+/*
+ * This function fills the board with a random solution, like doGenerate, and then empties its cells
+ * one at a time, in a random order, keeping every removal after which the board still has a single solution.
+ * It stops once Y cells are left, or, if minimize == 1, only once every cell was tried,
+ * which leaves a minimal board: none of its cells can be emptied without adding a solution.
+ * Every check counts the solutions with the native search up to 2, on the board with
+ * all the other cells still filled, so it is quick.
+ * It updates the new board into *retBoard, and the number of cells left through *pGivens.
+ * Return values:
+ * -3: the budget of the command ran out.
+ * -1: memory allocation failed.
+ *  0: the board has no solution.
+ *  1: the board was successfully generated, and setted to *retBoard.
+ */
+int doGenerateUnique(struct sudokuManager *board, int Y, int minimize, int *retBoard, int *pGivens){
+    int i, j, tmp, res, row, col, val, N = boardLen(board), area = boardArea(board), *order;
+    struct sudokuManager solved;
+    struct boardView view;
+
+    res = generateByRandomFill(board, 0, area, retBoard); /* leaves every cell */
+    if (res != 1){
+        return res;
+    }
+    order = (int *)malloc(area * sizeof(int));
+    if (order == NULL){
+        return -1;
+    }
+    for (i = 0; i < area; i++){
+        order[i] = i;
+    }
+    for (i = area - 1; i > 0; i--){
+        j = randRangeInt(0, i + 1);
+        tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+    solved = *board;
+    solved.board = retBoard;
+    solved.emptyCells = 0;
+    if (initBoardView(&view, &solved) == -1){
+        free(order);
+        return -1;
+    }
+    *pGivens = area;
+    res = 1;
+    for (i = 0; (i < area) && (minimize || (*pGivens > Y)); i++){
+        row = order[i] / N;
+        col = order[i] % N;
+        val = viewCell(&view, row, col);
+        if (setViewCell(&view, row, col, 0) == -1){
+            res = -1;
+            break;
         }
-
-        if(updateAutofillValuesBoard(newManager) == -1){ /* autofilling values in the new manager */
-            freeBoard(newManager);
-            return -1;
+        res = countSolutionsNative(&view, 2);
+        if ((res == -2) || (res == -4)){
+            res = (res == -2) ? -1 : -3;
+            break;
+        }
+        if (res == 1){ /* still a single solution */
+            (*pGivens)--;
         }
+        else if (setViewCell(&view, row, col, val) == -1){
+            res = -1;
+            break;
+        }
+        res = 1;
+    }
+    if (res == 1){
+        copyViewToBoard(&view, retBoard);
+    }
+    freeBoardView(&view);
+    free(order);
+    return res;
+}
 
-        retGurobi = solveBoard(newManager, &retBoard); /* solve the board with the new X filled cells */
-        if(retGurobi == -2){ /* allocation failed... */
-            freeBoard(newManager);
-            return -1;
+/*
+ * This function generates boards with a single solution, like doGenerateUnique with Y cells left,
+ * until the hardest technique the grader needs to solve one of them is target, or attempts boards were made.
+ * It updates the last board into *retBoard, its number of cells left through *pGivens, and its grade through *grade.
+ * Return values:
+ * -4: the board is longer than the grader can grade.
+ * -3: the budget of the command ran out.
+ * -1: memory allocation failed.
+ *  0: the board has no solution.
+ *  1: a board of grade target was generated, and setted to *retBoard.
+ *  2: none of the boards was of grade target.
+ */
+int doGenerateGraded(struct sudokuManager *board, int Y, enum gradeTechnique target, int attempts,
+                     int *retBoard, int *pGivens, struct boardGrade *grade){
+    int i, res;
+    for (i = 0; i < attempts; i++){
+        res = doGenerateUnique(board, Y, 0, retBoard, pGivens);
+        if (res != 1){
+            return res;
         }
-        else {
-            if(retGurobi == 1){ /* solution has been found!!! Hurray!!! */
-                doGenerateRemoveNumRandomCells(board, retBoard, boardArea(board) - Y);
-                /* This function removes cells */
-                freeBoard(newManager);
-                return 1;
-            }
+        res = gradeBoard(retBoard, board->m, board->n, grade);
+        if (res != 1){ /* a board with a single solution always has a grade */
+            return (res == -2) ? -4 : -1;
+        }
+        if (grade->hardest == target){
+            return 1;
+        }
+        if (budgetExhausted()){
+            return -3;
         }
     }
-    freeBoard(newManager);
-    return 0; /* after 1000 attempts we return we didn't succeed*/
+    return 2;
 }
 
 /* HINT */
 
 /*
  * This function fills in *hint a hint for cell <row,col>.
+ * The hint is taken from the witness solution if it still agrees with the board.
  * Return values:
- * -2: Gurobi failure.
+ * -3: the budget of the command ran out.
+ * -2: solver backend failure.
  * -1: memory allocation failed.
  *  0: the board is invalid.
  *  1: the board is valid and solving the board succeeded.
@@ -237,32 +536,46 @@ int doGenerate(struct sudokuManager *board, int X, int Y, int *retBoard){
 int getHint(struct sudokuManager *manager, int row, int col, int* hint){
     int res;
     int *retBoard;
-    struct  sudokuManager *newManager;
+    struct boardView view;
 
-    if (helperManager(&newManager, manager) == -1){ /* memory allocation failed */
+    if (witnessAgrees(manager)){
+        *hint = witness[matIndex(manager->m, manager->n, row, col)];
+        return 1;
+    }
+    if (initBoardView(&view, manager) == -1){ /* memory allocation failed */
+        return -1;
+    }
+    retBoard = (int *)malloc(boardArea(manager) * sizeof(int));
+    if ((retBoard == NULL) || (autofillBoardView(&view) == -1)){
+        free(retBoard);
+        freeBoardView(&view);
         return -1;
     }
 
-    retBoard = newManager->board;
-
-    res = solveBoard(newManager, &retBoard);
+    res = backendSolveBoard(&view, retBoard);
+    freeBoardView(&view);
     if(res == -1){
-        freeBoard(newManager);
+        free(retBoard);
         return -2;
     }
     else{
-        if(res == -2){ /* allocation failed in Gurobi  */
-            freeBoard(newManager);
+        if(res == -2){ /* allocation failed in the backend */
+            free(retBoard);
             return -1;
         }
+        else if (res == -4){ /* the budget ran out */
+            free(retBoard);
+            return -3;
+        }
         else{
             if(res == 0){ /* the board is not valid */
-                freeBoard(newManager);
+                free(retBoard);
                 return 0;
             }
             else {
+                keepWitness(manager, retBoard);
                 *hint = retBoard[matIndex(manager->m, manager->n, row, col)];
-                freeBoard(newManager);
+                free(retBoard);
                 return 1;
             }
         }
@@ -274,6 +587,7 @@ int getHint(struct sudokuManager *manager, int row, int col, int* hint){
 /*
  * This function guesses a hint for cell <row, col> using LP.
  *  Return values:
+ *  -3: the budget of the command ran out.
  *  -2: there was a nonfatal error because of which we can't execute
  *      the command and need to continue.
  *  -1: memory allocation failed.
@@ -283,15 +597,20 @@ int getHint(struct sudokuManager *manager, int row, int col, int* hint){
  */
 int doGuessHint(struct sudokuManager *manager, int row, int col, int **pCellValues, double **pScores, int *pLength) {
     int res, value;
-    struct  sudokuManager *newManager;
+    struct boardView view;
 
-    if (helperManager(&newManager, manager) == -1){ /* allocation failed */
+    if (initBoardView(&view, manager) == -1){ /* allocation failed */
+        return -1;
+    }
+    if (autofillBoardView(&view) == -1){
+        freeBoardView(&view);
         return -1;
     }
 
     /* initializing *pCellValues and *pLength */
-    value = newManager->board[matIndex(manager->m, manager->n,  row, col)];
+    value = viewCell(&view, row, col);
     if (value != 0){
+        freeBoardView(&view);
         *pCellValues = (int *)malloc(1 * sizeof(int));
         *pScores = (double *)malloc(1 * sizeof(double));
         if ((*pScores == NULL) || (*pCellValues == NULL)){
@@ -302,16 +621,15 @@ int doGuessHint(struct sudokuManager *manager, int row, int col, int **pCellValu
         (*pScores)[0] = 1;
         (*pCellValues)[0] = value;
         *pLength = 1;
-        freeBoard(newManager);
         return 1;
     }
 
     *pCellValues = NULL;
     *pLength = 0;
 
-    res = guessCellValues(newManager, row, col, pCellValues, pScores, pLength);
-    freeBoard(newManager);
-    if (res == -1){ /* Gurobi error */
+    res = backendGuessCellValues(&view, row, col, pCellValues, pScores, pLength);
+    freeBoardView(&view);
+    if (res == -1){ /* backend error */
         return -2;
     }
 
@@ -319,6 +637,81 @@ int doGuessHint(struct sudokuManager *manager, int row, int col, int **pCellValu
         return -1;
     }
 
+    if (res == -4){ /* the budget ran out */
+        return -3;
+    }
+
+    return res;
+}
+
+/*
+ * This function guesses the values of every empty cell of the board using LP, from a single solve:
+ * the relaxation is solved for the first cell, and the other cells read it from the cache of the backend.
+ * The values of cell <row, col> are (*pValues)[(*pStarts)[cell]..(*pStarts)[cell + 1] - 1],
+ * and their scores are at the same positions of *pScores, where cell = row * N + col.
+ * A filled cell has no values, and a cell the autofill of the board fills has its value with score 1.
+ *  Return values:
+ *  -3: the budget of the command ran out.
+ *  -2: there was a nonfatal error because of which we can't execute
+ *      the command and need to continue.
+ *  -1: memory allocation failed.
+ *   1: the board is solvable.
+ *   0: the board is unsolvable.
+ *  User needs to free *pValues, *pScores and *pStarts iff return value == 1.
+ */
+int doGuessHintAll(struct sudokuManager *manager, int **pValues, double **pScores, int **pStarts){
+    int row, col, k, res = 1, length, *cellValues, N = boardLen(manager), pos = 0;
+    double *cellScores;
+    struct boardView view;
+
+    if (initBoardView(&view, manager) == -1){
+        return -1;
+    }
+    *pValues = (int *)malloc((N * N * N + 1) * sizeof(int));
+    *pScores = (double *)malloc((N * N * N + 1) * sizeof(double));
+    *pStarts = (int *)malloc((N * N + 1) * sizeof(int));
+    if ((*pValues == NULL) || (*pScores == NULL) || (*pStarts == NULL) || (autofillBoardView(&view) == -1)){
+        res = -2; /* memory allocation failed, reported like a failure in the backend */
+    }
+    for (row = 0; (row < N) && (res == 1); row++){
+        for (col = 0; (col < N) && (res == 1); col++){
+            (*pStarts)[row * N + col] = pos;
+            if (manager->board[matIndex(manager->m, manager->n, row, col)] != 0){ /* not a cell to guess */
+                continue;
+            }
+            if (viewCell(&view, row, col) != 0){ /* filled by the autofill */
+                (*pValues)[pos] = viewCell(&view, row, col);
+                (*pScores)[pos++] = 1;
+                continue;
+            }
+            res = backendGuessCellValues(&view, row, col, &cellValues, &cellScores, &length);
+            if (res == 1){
+                for (k = 0; k < length; k++){
+                    (*pValues)[pos] = cellValues[k];
+                    (*pScores)[pos++] = cellScores[k];
+                }
+                free(cellValues);
+                free(cellScores);
+            }
+        }
+    }
+    freeBoardView(&view);
+    if (res == 1){
+        (*pStarts)[N * N] = pos;
+        return 1;
+    }
+    free(*pValues);
+    free(*pScores);
+    free(*pStarts);
+    if (res == -1){ /* backend error */
+        return -2;
+    }
+    if (res == -2){ /* memory allocation error */
+        return -1;
+    }
+    if (res == -4){ /* the budget ran out */
+        return -3;
+    }
     return res;
 }
 
@@ -387,6 +780,15 @@ void pop(Stack *s){
     free(node);
 }
 
+/*
+ * This method pops every element out of the stack.
+ */
+void clearStack(Stack *s){
+    while (!isEmpty(s)){
+        pop(s);
+    }
+}
+
 /*
  * This method returns the first element of the stack.
  */
@@ -447,11 +849,14 @@ int findNextLegalValue(int m, int n, int row, int col, int *solutionBoard){
 
 /*
  * This method performs backtracking.
+ * Every step of the search is charged to the budget of the command as a node,
+ * and it returns -3 once the budget ran out.
  */
 int recBacktracking(struct sudokuManager *manager, int *solutionBoard) {
     int n = manager->n;
     int m = manager->m;
     int row = 0, col = 0, numSolutions = 0, N = boardLen(manager), value;
+    long nodes = 0;
     int *pRow = &row, *pCol = &col;
     Node *node;
 
@@ -484,6 +889,14 @@ int recBacktracking(struct sudokuManager *manager, int *solutionBoard) {
 
     while (!isEmpty(s)) { /* while the stack is not empty and there are more
                            * possible values for the current cell */
+        if ((++nodes % BUDGET_POLL_NODES) == 0){
+            chargeBudget(nodeBudget, BUDGET_POLL_NODES);
+            if (budgetExhausted()){
+                clearStack(s);
+                free(s);
+                return -3;
+            }
+        }
         node = top(s);
         if (node->value == N + 1){ /* checking if there are more possible values for the current cell
             * node->value == N + 1 iff there are no more legal values to check for this cell */
@@ -528,6 +941,7 @@ int recBacktracking(struct sudokuManager *manager, int *solutionBoard) {
             }
         }
     }
+    chargeBudget(nodeBudget, nodes % BUDGET_POLL_NODES);
     free(s);
     return numSolutions;
 }
@@ -536,6 +950,7 @@ int recBacktracking(struct sudokuManager *manager, int *solutionBoard) {
  * This function returns the number of possible solutions of the current board
  * using the backtracking algorithm.
  * Return values:
+ * -3: the budget of the command ran out.
  * -1: memory allocation failed.
  * numSolutions: returns the number of solutions to the board >= 0.
  */
@@ -1,7 +1,7 @@
 /*
  * This module handles everything that has to do with solving the board.
- * It communicates with game.c and gurobi.c. game.c tells this module what command it wants to be done,
- * and this module prepares everything needed to call functions from gurobi.c to solve the board, or validate it.
+ * It communicates with game.c and the solver backends (backend.c). game.c tells this module what command it wants
+ * to be done, and this module prepares everything needed to call the selected backend to solve the board, or validate it.
  * In addition, it contains everything regarding the backtracking algorithm used to count the number of possible
  * solutions to the current board.
  */
@@ -13,13 +13,22 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "util/board_manager.h"
+#include "grader.h"
+
+/*
+ * This function frees the witness solution, the last full solution found,
+ * which validateBoard and getHint reuse while it agrees with the board.
+ */
+void releaseSolverCache();
 
 /* VALIDATE */
 
 /*
  * This function validates a board using ILP.
+ * The board is not solved again if the witness solution still agrees with it.
  * Return values:
- * -2: Gurobi failure.
+ * -3: the budget of the command ran out.
+ * -2: solver backend failure.
  * -1: memory allocation failed.
  *  0: the board is invalid.
  *  1: the board is valid.
@@ -32,34 +41,75 @@ int validateBoard(struct sudokuManager *manager);
  * This function guesses a solution for the entire board and
  * fills its cells with values with higher probability than [threshold]
  * to appear in a solution to the board.
+ * The LP is solved once and rounded samples times, and the rounding which filled the most cells is kept.
  * Return values:
- * -2: Gurobi failure.
+ * -3: the budget of the command ran out.
+ * -2: solver backend failure.
  * -1: memory allocation failed.
  *  0: The board is invalid.
  *  1: The board is valid and the guessed solution is filled in retBoard.
  */
-int doGuess(struct sudokuManager *manager, float threshold, int *retBoard);
+int doGuess(struct sudokuManager *manager, float threshold, int samples, int *retBoard);
 
 /* GENERATE */
 
 /*
- * This function raffles X cells and fill it with legal values,
- * solves the board and leave Y cells out of the solution,
- * to generate a new board.
+ * This function fills X random empty cells of the board with legal values, fills the rest of it with
+ * a random solution, and leaves Y cells of it, to generate a new board.
+ * The solution is found by a random native search, which keeps the cells already filled. If the raffled
+ * cells leave no solution they are raffled again, up to a few times,
+ * and then the board is filled without them.
+ * If the backend has a solution pool, the solution is drawn instead from a pool of solutions
+ * found in a single solve, which later generates keep drawing from while its solutions agree
+ * with the board. The X cells would be filled from the drawn solution, so they are not raffled.
  * It updates the new board into *retBoard.
  * Return values:
+ * -3: the budget of the command ran out.
  * -1: memory allocation failed.
- *  0: generating board failed after many attempts.
+ *  0: the board has no solution.
  *  1: the board was successfully generated, and setted to *retBoard.
  */
 int doGenerate(struct sudokuManager *prevBoard, int X, int Y, int *retBoard);
 
+/*
+ * This function fills the board with a random solution, like doGenerate, and then empties its cells
+ * one at a time, in a random order, keeping every removal after which the board still has a single solution.
+ * It stops once Y cells are left, or, if minimize == 1, only once every cell was tried,
+ * which leaves a minimal board: none of its cells can be emptied without adding a solution.
+ * Every check counts the solutions with the native search up to 2, on the board with
+ * all the other cells still filled, so it is quick.
+ * It updates the new board into *retBoard, and the number of cells left through *pGivens.
+ * Return values:
+ * -3: the budget of the command ran out.
+ * -1: memory allocation failed.
+ *  0: the board has no solution.
+ *  1: the board was successfully generated, and setted to *retBoard.
+ */
+int doGenerateUnique(struct sudokuManager *board, int Y, int minimize, int *retBoard, int *pGivens);
+
+/*
+ * This function generates boards with a single solution, like doGenerateUnique with Y cells left,
+ * until the hardest technique the grader needs to solve one of them is target, or attempts boards were made.
+ * It updates the last board into *retBoard, its number of cells left through *pGivens, and its grade through *grade.
+ * Return values:
+ * -4: the board is longer than the grader can grade.
+ * -3: the budget of the command ran out.
+ * -1: memory allocation failed.
+ *  0: the board has no solution.
+ *  1: a board of grade target was generated, and setted to *retBoard.
+ *  2: none of the boards was of grade target.
+ */
+int doGenerateGraded(struct sudokuManager *board, int Y, enum gradeTechnique target, int attempts,
+                     int *retBoard, int *pGivens, struct boardGrade *grade);
+
 /* HINT */
 
 /*
  * This function fills in *hint a hint for cell <row,col>.
+ * The hint is taken from the witness solution if it still agrees with the board.
  * Return values:
- * -2: Gurobi failure.
+ * -3: the budget of the command ran out.
+ * -2: solver backend failure.
  * -1: memory allocation failed.
  *  0: the board is invalid.
  *  1: the board is valid and solving the board succeeded.
@@ -71,6 +121,7 @@ int getHint(struct sudokuManager *manager, int row, int col, int* hint);
 /*
  * This function guesses a hint for cell (row, col) using LP.
  *  Return values:
+ *  -3: the budget of the command ran out.
  *  -2: there was a nonfatal error because of which we can't execute
  *      the command and need to continue.
  *  -1: memory allocation failed.
@@ -80,12 +131,30 @@ int getHint(struct sudokuManager *manager, int row, int col, int* hint);
  */
 int doGuessHint(struct sudokuManager *manager, int row, int col, int **pCellValues, double **pScores, int *pLength);
 
+/*
+ * This function guesses the values of every empty cell of the board using LP, from a single solve:
+ * the relaxation is solved for the first cell, and the other cells read it from the cache of the backend.
+ * The values of cell <row, col> are (*pValues)[(*pStarts)[cell]..(*pStarts)[cell + 1] - 1],
+ * and their scores are at the same positions of *pScores, where cell = row * N + col.
+ * A filled cell has no values, and a cell the autofill of the board fills has its value with score 1.
+ *  Return values:
+ *  -3: the budget of the command ran out.
+ *  -2: there was a nonfatal error because of which we can't execute
+ *      the command and need to continue.
+ *  -1: memory allocation failed.
+ *   1: the board is solvable.
+ *   0: the board is unsolvable.
+ *  User needs to free *pValues, *pScores and *pStarts iff return value == 1.
+ */
+int doGuessHintAll(struct sudokuManager *manager, int **pValues, double **pScores, int **pStarts);
+
 /* NUM_SOLUTIONS */
 
 /*
  * This function returns the number of possible solutions of the current board
  * using the backtracking algorithm.
  * Return values:
+ * -3: the budget of the command ran out.
  * -1: memory allocation failed.
  * numSolutions: returns the number of solutions to the board >= 0.
  */
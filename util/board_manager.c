@@ -46,6 +46,14 @@ void getFirstIndexInBlock(int m, int n, int blockNum, int *pRow, int *pCol){
     *pCol = n * (blockNum % m);
 }
 
+/*
+ * This method returns the number of the block of cell <row, col>.
+ * It is the inverse of getFirstIndexInBlock.
+ */
+int blockNum(int m, int n, int row, int col){
+    return (row / m) * m + (col / n);
+}
+
 /*
  * This method returns the length of the sudoku board.
  */
@@ -318,14 +326,10 @@ int amountOfEmptyCells(struct sudokuManager *manager){
  * This method frees a given board.
  */
 void freeBoard(struct sudokuManager *board){
-    if (board->linkedList != NULL){
-        pointToFirstMoveInMovesList(board, 0); /* points the move's list to first move */
-        killNextMoves(board); /* frees all next moves */
-    }
+    freeMovesList(board->movesList);
     free(board->fixed);
     free(board->erroneous);
     free(board->board);
-    free(board->linkedList);
     free(board);
 }
 
@@ -466,9 +470,7 @@ int fillBoardWithSignleLegalValues(struct sudokuManager *board, int *tmp) {
 int updateAutofillValuesBoard(struct sudokuManager *board){
     int* tmp;
     /* destroy all next moves in the boards' move list */
-    if (board->linkedList->next != NULL){
-        killNextMoves(board);
-    }
+    killNextMoves(board);
     tmp = calloc(boardArea(board), sizeof(int));
     if(tmp == NULL){
         return -1;
@@ -479,11 +481,7 @@ int updateAutofillValuesBoard(struct sudokuManager *board){
         return -1;
     }
     free(tmp);
-    if(createNextNode(board, separator, 0, 0, 0, 0) == -1){
-        return -1;
-    }
-    goToNextNode(board);
-    return 0;
+    return endMovesBatch(board);
 }
 
 /*
@@ -510,14 +508,8 @@ int doSet(struct sudokuManager *manager, int row, int col, int Z){
     int prevVal = manager->board[matIndex(manager->m, manager->n, row, col)];
     updateEmptyCellsSingleSet(manager, prevVal, Z); /* update the amount of emptyCells field */
     changeCellValue(manager->board, manager->m, manager->n, row, col, Z);
-    if (manager->linkedList->next != NULL){
-        killNextMoves(manager);
-    }
-    if (createNextNode(manager, command, row, col, Z, prevVal) == -1){
-        return -1;
-    }
-    goToNextNode(manager);
-    return 0;
+    markBoardChanged(manager);
+    return addMove(manager, row, col, prevVal, Z);
 }
 
 
@@ -533,12 +525,24 @@ void updateEmptyCellsField(struct sudokuManager *manager){
  */
 void initNullBoard(struct sudokuManager *manager){
     manager->board = NULL;
-    manager->linkedList = NULL;
+    manager->movesList = NULL;
     manager->fixed = NULL;
     manager->erroneous = NULL;
     manager->m = -1;
     manager->n = -1;
     manager->emptyCells = -1;
+    markBoardChanged(manager);
+}
+
+/* the last version given to any board */
+static long lastVersion = 0;
+
+/*
+ * This method gives the board of manager a new version,
+ * so everything computed for its previous version is known to be outdated.
+ */
+void markBoardChanged(struct sudokuManager *manager){
+    manager->version = ++lastVersion;
 }
 
 /*
@@ -551,8 +555,8 @@ void initBoardValues(struct sudokuManager *boardToFill, int m, int n, int *board
     boardToFill->erroneous = erroneous;
     boardToFill->fixed= fixed;
     boardToFill->emptyCells = emptyCells;
-    boardToFill->linkedList = list;
-    initList(boardToFill->linkedList);
-    boardToFill->linkedList->board = boardToFill;
+    markBoardChanged(boardToFill);
+    boardToFill->movesList = list;
+    initMovesList(boardToFill->movesList);
 }
 
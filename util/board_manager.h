@@ -7,7 +7,7 @@
 #ifndef SOFTWAREPROJECTFINALPROJECT_BOARD_MANAGER_H
 #define SOFTWAREPROJECTFINALPROJECT_BOARD_MANAGER_H
 
-#include "linked_list.h"
+#include "moves_list.h"
 
 enum Mode {
     Init = 0,
@@ -21,8 +21,9 @@ struct sudokuManager {
     int *board;
     int *fixed;
     int *erroneous;
-    struct movesList *linkedList;
+    struct movesList *movesList;
     int emptyCells;
+    long version; /* changes whenever the board changes, and is never shared by two boards */
 };
 
 /* GENERAL METHODS */
@@ -47,6 +48,12 @@ int colLowBound(int n, int column);
  */
 int colHighBound(int n, int column);
 
+/*
+ * This method returns the number of the block of cell <row, col>.
+ * It is the inverse of getFirstIndexInBlock.
+ */
+int blockNum(int m, int n, int row, int col);
+
 /*
  * This method returns the length of the sudoku board.
  */
@@ -191,9 +198,16 @@ void updateEmptyCellsField(struct sudokuManager *manager);
 
 /*
  * This method sets all pointers in board to NULL and all integers to -1.
+ * The board gets a version of its own.
  */
 void initNullBoard(struct sudokuManager *manager);
 
+/*
+ * This method gives the board of manager a new version,
+ * so everything computed for its previous version is known to be outdated.
+ */
+void markBoardChanged(struct sudokuManager *manager);
+
 /*
 * This function updated the board values by given parameters.
 */
@@ -0,0 +1,246 @@
+/*
+ * This module deals with everything that has to do with the boardView struct.
+ * A board view is a lightweight, copy-on-write view of a sudokuManager's board:
+ * it reads the parent board directly, and copies a row of the parent board only
+ * the first time one of its cells is modified through the view.
+ * The parent board itself is never changed through a view.
+ */
+
+#include <stdlib.h>
+#include "board_view.h"
+
+/*
+ * This function initializes view to share manager's board.
+ * No cell is copied until it is modified through the view.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the view was initialized successfully.
+ * User needs to call freeBoardView iff return value == 0.
+ */
+int initBoardView(struct boardView *view, struct sudokuManager *manager){
+    int N = boardLen(manager);
+    view->m = manager->m;
+    view->n = manager->n;
+    view->base = manager->board;
+    view->baseEmptyCells = manager->emptyCells;
+    view->rows = (int **)malloc(N * sizeof(int *));
+    view->copies = (int **)calloc(N, sizeof(int *));
+    if ((view->rows == NULL) || (view->copies == NULL)){
+        free(view->rows);
+        free(view->copies);
+        return -1;
+    }
+    resetBoardView(view);
+    return 0;
+}
+
+/*
+ * This function frees all memory owned by view.
+ * It does not free the parent board.
+ */
+void freeBoardView(struct boardView *view){
+    int row, N = viewLen(view);
+    for (row = 0; row < N; row++){
+        free(view->copies[row]);
+    }
+    free(view->copies);
+    free(view->rows);
+    view->copies = NULL;
+    view->rows = NULL;
+}
+
+/*
+ * This function drops every modification made through view,
+ * so it shows the parent board again. Copied rows are kept for reuse.
+ */
+void resetBoardView(struct boardView *view){
+    int row, N = viewLen(view);
+    for (row = 0; row < N; row++){
+        view->rows[row] = view->base + matIndex(view->m, view->n, row, 0);
+    }
+    view->emptyCells = view->baseEmptyCells;
+}
+
+/*
+ * This method returns the length of the board seen through view.
+ */
+int viewLen(struct boardView *view){
+    return (view->m)*(view->n);
+}
+
+/*
+ * This method returns a hash of the m, n and cells of the board seen through view (FNV-1a).
+ * Equal boards have equal hashes, so boards with different hashes differ.
+ */
+unsigned long viewHash(struct boardView *view){
+    int row, col, N = viewLen(view);
+    unsigned long hash = 2166136261UL;
+    hash = (hash ^ (unsigned long)view->m) * 16777619UL;
+    hash = (hash ^ (unsigned long)view->n) * 16777619UL;
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            hash = (hash ^ (unsigned long)viewCell(view, row, col)) * 16777619UL;
+        }
+    }
+    return hash;
+}
+
+/*
+ * This method returns the value of cell <row, col> as seen through view.
+ */
+int viewCell(struct boardView *view, int row, int col){
+    return view->rows[row][col];
+}
+
+/*
+ * This function makes row of view point to the view's private copy of it.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the row is now owned by view.
+ */
+int ownViewRow(struct boardView *view, int row){
+    int col, N = viewLen(view);
+    if (view->rows[row] == view->copies[row]){ /* already copied */
+        return 0;
+    }
+    if (view->copies[row] == NULL){
+        view->copies[row] = (int *)malloc(N * sizeof(int));
+        if (view->copies[row] == NULL){
+            return -1;
+        }
+    }
+    for (col = 0; col < N; col++){
+        view->copies[row][col] = view->rows[row][col];
+    }
+    view->rows[row] = view->copies[row];
+    return 0;
+}
+
+/*
+ * This function sets val into cell <row, col> of view,
+ * copying the cell's row from the parent board if needed.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the value was set.
+ */
+int setViewCell(struct boardView *view, int row, int col, int val){
+    int prevVal = view->rows[row][col];
+    if (prevVal == val){
+        return 0;
+    }
+    if (ownViewRow(view, row) == -1){
+        return -1;
+    }
+    view->rows[row][col] = val;
+    if (prevVal == 0){
+        view->emptyCells--;
+    }
+    else if (val == 0){
+        view->emptyCells++;
+    }
+    return 0;
+}
+
+/*
+ * This method returns 1 if the row/col/block of <row, col> in view contains val at least once.
+ */
+int viewNeighbourContainsOnce(struct boardView *view, int row, int col, int val){
+    int i, j, N = viewLen(view);
+    int blockRowHighBound = rowHighBound(view->m, row);
+    int blockColHighBound = colHighBound(view->n, col);
+    if (val == 0){
+        return 0;
+    }
+    for (i = 0; i < N; i++){
+        if ((view->rows[row][i] == val) || (view->rows[i][col] == val)){
+            return 1;
+        }
+    }
+    for (i = rowLowBound(view->m, row); i < blockRowHighBound; i++){
+        for (j = colLowBound(view->n, col); j < blockColHighBound; j++){
+            if (view->rows[i][j] == val){
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * This function works like returnLegalValue, on the board seen through view.
+ * if cell <row, col> has only one legal value to fill, it returns it.
+ * if there is no legal value, it returns -1.
+ * if there is more than one legal value, or the cell is not empty, it returns 0.
+ */
+int viewLegalValue(struct boardView *view, int row, int col){
+    int i, N = viewLen(view), value = 0;
+    if (view->rows[row][col] != 0){
+        return 0; /* cell is not empty */
+    }
+    for (i = 1; i <= N; i++){
+        if (!viewNeighbourContainsOnce(view, row, col, i)){
+            if (value != 0){ /* more than one legal value */
+                return 0;
+            }
+            value = i;
+        }
+    }
+    if (value == 0){ /* there is no legal value */
+        return -1;
+    }
+    return value;
+}
+
+/*
+ * This function autofills view: every empty cell that has a single legal value
+ * is filled with it, all cells being computed from the view before any of them is set.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: autofill succeeded.
+ */
+int autofillBoardView(struct boardView *view){
+    int row, col, val, i, count = 0, N = viewLen(view);
+    int *cells, *values;
+    if (view->emptyCells <= 0){
+        return 0;
+    }
+    cells = (int *)malloc(view->emptyCells * sizeof(int));
+    values = (int *)malloc(view->emptyCells * sizeof(int));
+    if ((cells == NULL) || (values == NULL)){
+        free(cells);
+        free(values);
+        return -1;
+    }
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            val = viewLegalValue(view, row, col);
+            if (val > 0){ /* there is only one legal value for <row, col> */
+                cells[count] = matIndex(view->m, view->n, row, col);
+                values[count] = val;
+                count++;
+            }
+        }
+    }
+    for (i = 0; i < count; i++){
+        if (setViewCell(view, cells[i] / N, cells[i] % N, values[i]) == -1){
+            free(cells);
+            free(values);
+            return -1;
+        }
+    }
+    free(cells);
+    free(values);
+    return 0;
+}
+
+/*
+ * This method copies the board seen through view into the array to.
+ */
+void copyViewToBoard(struct boardView *view, int *to){
+    int row, col, N = viewLen(view);
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            to[matIndex(view->m, view->n, row, col)] = view->rows[row][col];
+        }
+    }
+}
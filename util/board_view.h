@@ -0,0 +1,98 @@
+/*
+ * This module deals with everything that has to do with the boardView struct.
+ * A board view is a lightweight, copy-on-write view of a sudokuManager's board:
+ * it reads the parent board directly, and copies a row of the parent board only
+ * the first time one of its cells is modified through the view.
+ * The parent board itself is never changed through a view.
+ */
+
+#ifndef SOFTWAREPROJECTFINALPROJECT_BOARD_VIEW_H
+#define SOFTWAREPROJECTFINALPROJECT_BOARD_VIEW_H
+
+#include "board_manager.h"
+
+struct boardView {
+    int n;
+    int m;
+    int *base; /* the parent's board, read only */
+    int **rows; /* rows[row] points either into base or into copies[row] */
+    int **copies; /* copies[row] is the view's private copy of a row, or NULL */
+    int emptyCells;
+    int baseEmptyCells;
+};
+
+/*
+ * This function initializes view to share manager's board.
+ * No cell is copied until it is modified through the view.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the view was initialized successfully.
+ * User needs to call freeBoardView iff return value == 0.
+ */
+int initBoardView(struct boardView *view, struct sudokuManager *manager);
+
+/*
+ * This function frees all memory owned by view.
+ * It does not free the parent board.
+ */
+void freeBoardView(struct boardView *view);
+
+/*
+ * This function drops every modification made through view,
+ * so it shows the parent board again. Copied rows are kept for reuse.
+ */
+void resetBoardView(struct boardView *view);
+
+/*
+ * This method returns the length of the board seen through view.
+ */
+int viewLen(struct boardView *view);
+
+/*
+ * This method returns a hash of the m, n and cells of the board seen through view (FNV-1a).
+ * Equal boards have equal hashes, so boards with different hashes differ.
+ */
+unsigned long viewHash(struct boardView *view);
+
+/*
+ * This method returns the value of cell <row, col> as seen through view.
+ */
+int viewCell(struct boardView *view, int row, int col);
+
+/*
+ * This function sets val into cell <row, col> of view,
+ * copying the cell's row from the parent board if needed.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the value was set.
+ */
+int setViewCell(struct boardView *view, int row, int col, int val);
+
+/*
+ * This method returns 1 if the row/col/block of <row, col> in view contains val at least once.
+ */
+int viewNeighbourContainsOnce(struct boardView *view, int row, int col, int val);
+
+/*
+ * This function works like returnLegalValue, on the board seen through view.
+ * if cell <row, col> has only one legal value to fill, it returns it.
+ * if there is no legal value, it returns -1.
+ * if there is more than one legal value, or the cell is not empty, it returns 0.
+ */
+int viewLegalValue(struct boardView *view, int row, int col);
+
+/*
+ * This function autofills view: every empty cell that has a single legal value
+ * is filled with it, all cells being computed from the view before any of them is set.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: autofill succeeded.
+ */
+int autofillBoardView(struct boardView *view);
+
+/*
+ * This method copies the board seen through view into the array to.
+ */
+void copyViewToBoard(struct boardView *view, int *to);
+
+#endif
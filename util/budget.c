@@ -0,0 +1,103 @@
+/*
+ * This module keeps the budget every command has for solving the board: a wall time,
+ * a number of search nodes and a number of LP/ILP iterations, each unlimited unless set.
+ * Every command starts a new budget, the solvers charge their work to it,
+ * and they give up once any part of it runs out.
+ * The race backend and generate_batch solve on several threads at once, so the budget is kept under a lock.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <time.h>
+#include <pthread.h>
+#include "budget.h"
+
+static pthread_mutex_t budgetLock = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK_BUDGET() pthread_mutex_lock(&budgetLock)
+#define UNLOCK_BUDGET() pthread_mutex_unlock(&budgetLock)
+
+static double limits[NUM_BUDGET_KINDS]; /* 0 for no limit */
+static double spent[NUM_BUDGET_KINDS]; /* spent[timeBudget] is unused, the time is measured from start */
+static double start; /* on the monotonic clock */
+
+/*
+ * This method returns the time in seconds on a monotonic clock, which is only meaningful
+ * as the difference of two readings.
+ */
+double monotonicSeconds(){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/*
+ * This method returns the seconds passed since the current command started.
+ */
+double secondsSinceStart(){
+    return monotonicSeconds() - start;
+}
+
+/*
+ * This function sets the limit of the given kind every command has from now on.
+ * A limit of 0 means there is no limit.
+ */
+void setBudgetLimit(enum budgetKind kind, double limit){
+    limits[kind] = limit;
+}
+
+/*
+ * This method returns the limit of the given kind every command has, or 0 if there is no limit.
+ */
+double budgetLimit(enum budgetKind kind){
+    return limits[kind];
+}
+
+/*
+ * This function starts the budget of a new command, with nothing spent yet.
+ */
+void startBudget(){
+    int kind;
+    LOCK_BUDGET();
+    for (kind = 0; kind < NUM_BUDGET_KINDS; kind++){
+        spent[kind] = 0;
+    }
+    start = monotonicSeconds();
+    UNLOCK_BUDGET();
+}
+
+/*
+ * This function charges amount nodes or iterations (by kind) to the budget of the current command.
+ */
+void chargeBudget(enum budgetKind kind, double amount){
+    LOCK_BUDGET();
+    spent[kind] += amount;
+    UNLOCK_BUDGET();
+}
+
+/*
+ * This method returns how much of the given kind the current command has left,
+ * 0 if it ran out, or -1 if there is no limit.
+ */
+double budgetLeft(enum budgetKind kind){
+    double left;
+    if (limits[kind] == 0){
+        return -1;
+    }
+    LOCK_BUDGET();
+    left = limits[kind] - ((kind == timeBudget) ? secondsSinceStart() : spent[kind]);
+    UNLOCK_BUDGET();
+    return (left > 0) ? left : 0;
+}
+
+/*
+ * This method returns 1 if any part of the budget of the current command ran out, and 0 otherwise.
+ */
+int budgetExhausted(){
+    int kind;
+    for (kind = 0; kind < NUM_BUDGET_KINDS; kind++){
+        if (budgetLeft((enum budgetKind)kind) == 0){
+            return 1;
+        }
+    }
+    return 0;
+}
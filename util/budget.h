@@ -0,0 +1,57 @@
+/*
+ * This module keeps the budget every command has for solving the board: a wall time,
+ * a number of search nodes and a number of LP/ILP iterations, each unlimited unless set.
+ * Every command starts a new budget, the solvers charge their work to it,
+ * and they give up once any part of it runs out.
+ */
+
+#ifndef SOFTWAREPROJECTFINALPROJECT_BUDGET_H
+#define SOFTWAREPROJECTFINALPROJECT_BUDGET_H
+
+enum budgetKind {
+    timeBudget = 0, /* in seconds */
+    nodeBudget = 1,
+    iterationBudget = 2
+};
+
+#define NUM_BUDGET_KINDS 3
+
+/*
+ * This method returns the time in seconds on a monotonic clock, which is only meaningful
+ * as the difference of two readings.
+ */
+double monotonicSeconds();
+
+/*
+ * This function sets the limit of the given kind every command has from now on.
+ * A limit of 0 means there is no limit.
+ */
+void setBudgetLimit(enum budgetKind kind, double limit);
+
+/*
+ * This method returns the limit of the given kind every command has, or 0 if there is no limit.
+ */
+double budgetLimit(enum budgetKind kind);
+
+/*
+ * This function starts the budget of a new command, with nothing spent yet.
+ */
+void startBudget();
+
+/*
+ * This function charges amount nodes or iterations (by kind) to the budget of the current command.
+ */
+void chargeBudget(enum budgetKind kind, double amount);
+
+/*
+ * This method returns how much of the given kind the current command has left,
+ * 0 if it ran out, or -1 if there is no limit.
+ */
+double budgetLeft(enum budgetKind kind);
+
+/*
+ * This method returns 1 if any part of the budget of the current command ran out, and 0 otherwise.
+ */
+int budgetExhausted();
+
+#endif
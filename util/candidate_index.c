@@ -0,0 +1,155 @@
+/*
+ * This module deals with everything that has to do with the candidateIndex struct.
+ * A candidate index lists the legal values of every empty cell of a board, and for every
+ * row/column/block and value missing from it, the cells of the unit that can still hold the value.
+ * Both lists are packed in flat arrays, so walking them costs as much as the open candidates.
+ */
+
+#include <stdlib.h>
+#include "candidate_index.h"
+
+/*
+ * This method returns the number of value v (0-based) of unit number unit of the given type.
+ */
+int unitKey(int N, enum unitType type, int unit, int v){
+    return ((int)type * N + unit) * N + v;
+}
+
+/*
+ * This function frees all memory owned by index.
+ */
+void freeCandidateIndex(struct candidateIndex *index){
+    free(index->cellStart);
+    free(index->cellValues);
+    free(index->unitStart);
+    free(index->unitCells);
+    free(index->unitFilled);
+    index->cellStart = index->cellValues = index->unitStart = index->unitCells = NULL;
+    index->unitFilled = NULL;
+}
+
+/*
+ * This method fills keys with the keys of value v (0-based) in the row, column and block of cell <row, col>.
+ */
+void cellUnitKeys(struct candidateIndex *index, int row, int col, int v, int *keys){
+    int N = index->m * index->n;
+    keys[rowUnit] = unitKey(N, rowUnit, row, v);
+    keys[colUnit] = unitKey(N, colUnit, col, v);
+    keys[blockUnit] = unitKey(N, blockUnit, blockNum(index->m, index->n, row, col), v);
+}
+
+/*
+ * This function builds the candidate index of the board seen through view.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the index was built successfully.
+ * User needs to call freeCandidateIndex iff return value == 0.
+ */
+int initCandidateIndex(struct candidateIndex *index, struct boardView *view){
+    int row, col, v, t, k, cell, val, N = viewLen(view), numKeys = NUM_UNIT_TYPES * N * N;
+    int keys[NUM_UNIT_TYPES];
+
+    index->m = view->m;
+    index->n = view->n;
+    index->numCandidates = 0;
+    index->cellValues = NULL;
+    index->unitCells = NULL;
+    index->cellStart = (int *)malloc((N * N + 1) * sizeof(int));
+    index->unitStart = (int *)calloc(numKeys + 1, sizeof(int));
+    index->unitFilled = (char *)calloc(numKeys, sizeof(char));
+    if ((index->cellStart == NULL) || (index->unitStart == NULL) || (index->unitFilled == NULL)){
+        freeCandidateIndex(index);
+        return -1;
+    }
+
+    /* marks the values every unit holds */
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            val = viewCell(view, row, col);
+            if (val != 0){
+                cellUnitKeys(index, row, col, val - 1, keys);
+                for (t = 0; t < NUM_UNIT_TYPES; t++){
+                    index->unitFilled[keys[t]] = 1;
+                }
+            }
+        }
+    }
+
+    /* counts the candidates of every cell and unit, unitStart[k + 1] is the count of key k for now */
+    for (row = 0; row < N; row++){
+        for (col = 0; col < N; col++){
+            cell = row * N + col;
+            index->cellStart[cell] = index->numCandidates;
+            if (viewCell(view, row, col) != 0){
+                continue;
+            }
+            for (v = 0; v < N; v++){
+                cellUnitKeys(index, row, col, v, keys);
+                if (!index->unitFilled[keys[rowUnit]] && !index->unitFilled[keys[colUnit]]
+                    && !index->unitFilled[keys[blockUnit]]){
+                    index->numCandidates++;
+                    for (t = 0; t < NUM_UNIT_TYPES; t++){
+                        index->unitStart[keys[t] + 1]++;
+                    }
+                }
+            }
+        }
+    }
+    index->cellStart[N * N] = index->numCandidates;
+    for (k = 0; k < numKeys; k++){
+        index->unitStart[k + 1] += index->unitStart[k];
+    }
+
+    index->cellValues = (int *)malloc((index->numCandidates + 1) * sizeof(int));
+    index->unitCells = (int *)malloc((NUM_UNIT_TYPES * index->numCandidates + 1) * sizeof(int));
+    if ((index->cellValues == NULL) || (index->unitCells == NULL)){
+        freeCandidateIndex(index);
+        return -1;
+    }
+
+    /* fills the lists, using unitStart[k] as the next free position of key k */
+    for (cell = 0; cell < N * N; cell++){
+        row = cell / N;
+        col = cell % N;
+        k = index->cellStart[cell];
+        if (viewCell(view, row, col) != 0){
+            continue;
+        }
+        for (v = 0; v < N; v++){
+            cellUnitKeys(index, row, col, v, keys);
+            if (!index->unitFilled[keys[rowUnit]] && !index->unitFilled[keys[colUnit]]
+                && !index->unitFilled[keys[blockUnit]]){
+                index->cellValues[k++] = v;
+                for (t = 0; t < NUM_UNIT_TYPES; t++){
+                    index->unitCells[index->unitStart[keys[t]]++] = cell;
+                }
+            }
+        }
+    }
+    /* every unitStart[k] now points to the start of key k + 1, shifts them back */
+    for (k = numKeys; k > 0; k--){
+        index->unitStart[k] = index->unitStart[k - 1];
+    }
+    index->unitStart[0] = 0;
+    return 0;
+}
+
+/*
+ * This method returns the legal values of cell <row, col>, and their amount through *pCount.
+ * A filled cell has no legal values.
+ */
+int *cellCandidates(struct candidateIndex *index, int row, int col, int *pCount){
+    int cell = row * index->m * index->n + col;
+    *pCount = index->cellStart[cell + 1] - index->cellStart[cell];
+    return index->cellValues + index->cellStart[cell];
+}
+
+/*
+ * This method returns the cells of unit number unit of the given type which can hold value v,
+ * and their amount through *pCount.
+ */
+int *unitCandidates(struct candidateIndex *index, enum unitType type, int unit, int v, int *pCount){
+    int key = unitKey(index->m * index->n, type, unit, v);
+    *pCount = index->unitStart[key + 1] - index->unitStart[key];
+    return index->unitCells + index->unitStart[key];
+}
@@ -0,0 +1,67 @@
+/*
+ * This module deals with everything that has to do with the candidateIndex struct.
+ * A candidate index lists the legal values of every empty cell of a board, and for every
+ * row/column/block and value missing from it, the cells of the unit that can still hold the value.
+ * Both lists are packed in flat arrays, so walking them costs as much as the open candidates.
+ */
+
+#ifndef SOFTWAREPROJECTFINALPROJECT_CANDIDATE_INDEX_H
+#define SOFTWAREPROJECTFINALPROJECT_CANDIDATE_INDEX_H
+
+#include "board_view.h"
+
+enum unitType {
+    rowUnit = 0,
+    colUnit = 1,
+    blockUnit = 2
+};
+
+#define NUM_UNIT_TYPES 3
+
+/*
+ * Values are 0-based. Cell <row, col> is numbered row * N + col,
+ * and value v of unit number unit of type type is numbered unitKey(N, type, unit, v).
+ */
+struct candidateIndex {
+    int m;
+    int n;
+    int numCandidates;
+    int *cellStart; /* N^2 + 1: the values of cell i are cellValues[cellStart[i]..cellStart[i + 1] - 1] */
+    int *cellValues;
+    int *unitStart; /* 3 * N^2 + 1: the cells of key k are unitCells[unitStart[k]..unitStart[k + 1] - 1] */
+    int *unitCells;
+    char *unitFilled; /* 3 * N^2: 1 if the unit already holds the value */
+};
+
+/*
+ * This method returns the number of value v (0-based) of unit number unit of the given type.
+ */
+int unitKey(int N, enum unitType type, int unit, int v);
+
+/*
+ * This function builds the candidate index of the board seen through view.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the index was built successfully.
+ * User needs to call freeCandidateIndex iff return value == 0.
+ */
+int initCandidateIndex(struct candidateIndex *index, struct boardView *view);
+
+/*
+ * This function frees all memory owned by index.
+ */
+void freeCandidateIndex(struct candidateIndex *index);
+
+/*
+ * This method returns the legal values of cell <row, col>, and their amount through *pCount.
+ * A filled cell has no legal values.
+ */
+int *cellCandidates(struct candidateIndex *index, int row, int col, int *pCount);
+
+/*
+ * This method returns the cells of unit number unit of the given type which can hold value v,
+ * and their amount through *pCount.
+ */
+int *unitCandidates(struct candidateIndex *index, enum unitType type, int unit, int v, int *pCount);
+
+#endif
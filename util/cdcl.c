@@ -0,0 +1,558 @@
+/*
+ * This module deals with everything that has to do with the cdclSolver struct.
+ * A CDCL solver decides whether a formula in conjunctive normal form can be satisfied:
+ * it propagates with two watched literals per clause, learns a clause from every conflict,
+ * picks its decisions by the activity of the variables in recent conflicts, and restarts
+ * on the Luby sequence.
+ * The formula is solved under assumptions, literals which hold for a single solve only,
+ * so the clauses it learnt keep helping the solves which follow with other assumptions.
+ * The learnt clauses are all dropped on a restart once they outgrow the formula.
+ */
+
+#include <stdlib.h>
+#include "cdcl.h"
+#include "budget.h"
+
+#define CDCL_RESTART_CONFLICTS 100 /* the conflicts between restarts, times the Luby sequence */
+#define CDCL_ACTIVITY_DECAY 0.95
+#define CDCL_ACTIVITY_LIMIT 1e100
+#define CDCL_MIN_LEARNT_LITS 100000 /* the learnt clauses are never dropped below this size */
+#define BUDGET_POLL_NODES 1024 /* the decisions are charged to the budget of the command in batches of this size */
+
+/*
+ * This method returns 1 if lit is true, -1 if it is false, and 0 if it is unassigned.
+ */
+int cdclLitValue(struct cdclSolver *s, int lit){
+    int val = s->values[lit >> 1];
+    return (lit & 1) ? -val : val;
+}
+
+/*
+ * This method returns the i'th element (0-based) of the Luby sequence 1, 1, 2, 1, 1, 2, 4, ...
+ */
+long cdclLuby(int i){
+    int size, seq;
+    for (size = 1, seq = 0; size < i + 1; seq++){
+        size = 2 * size + 1;
+    }
+    while (size - 1 != i){
+        size = (size - 1) >> 1;
+        seq--;
+        i = i % size;
+    }
+    return 1L << seq;
+}
+
+/*
+ * This method moves the variable at position i of the heap up, until its parent is at least as active.
+ */
+void cdclHeapUp(struct cdclSolver *s, int i){
+    int v = s->heap[i], parent;
+    while (i > 0){
+        parent = (i - 1) / 2;
+        if (s->activity[s->heap[parent]] >= s->activity[v]){
+            break;
+        }
+        s->heap[i] = s->heap[parent];
+        s->heapPos[s->heap[i]] = i;
+        i = parent;
+    }
+    s->heap[i] = v;
+    s->heapPos[v] = i;
+}
+
+/*
+ * This method moves the variable at position i of the heap down, until its children are at most as active.
+ */
+void cdclHeapDown(struct cdclSolver *s, int i){
+    int v = s->heap[i], child;
+    while (2 * i + 1 < s->heapSize){
+        child = 2 * i + 1;
+        if ((child + 1 < s->heapSize) && (s->activity[s->heap[child + 1]] > s->activity[s->heap[child]])){
+            child++;
+        }
+        if (s->activity[s->heap[child]] <= s->activity[v]){
+            break;
+        }
+        s->heap[i] = s->heap[child];
+        s->heapPos[s->heap[i]] = i;
+        i = child;
+    }
+    s->heap[i] = v;
+    s->heapPos[v] = i;
+}
+
+/*
+ * This method adds variable v to the heap, unless it is already in it.
+ */
+void cdclHeapInsert(struct cdclSolver *s, int v){
+    if (s->heapPos[v] != -1){
+        return;
+    }
+    s->heap[s->heapSize] = v;
+    s->heapPos[v] = s->heapSize;
+    cdclHeapUp(s, s->heapSize++);
+}
+
+/*
+ * This method removes the most active variable from the heap and returns it, or returns -1 if the heap is empty.
+ */
+int cdclHeapPop(struct cdclSolver *s){
+    int v;
+    if (s->heapSize == 0){
+        return -1;
+    }
+    v = s->heap[0];
+    s->heapPos[v] = -1;
+    s->heapSize--;
+    if (s->heapSize > 0){
+        s->heap[0] = s->heap[s->heapSize];
+        cdclHeapDown(s, 0);
+    }
+    return v;
+}
+
+/*
+ * This method raises the activity of variable v, which took part in a conflict.
+ */
+void cdclBumpActivity(struct cdclSolver *s, int v){
+    int i;
+    s->activity[v] += s->activityInc;
+    if (s->activity[v] > CDCL_ACTIVITY_LIMIT){ /* rescale, keeping the order */
+        for (i = 0; i < s->numVars; i++){
+            s->activity[i] /= CDCL_ACTIVITY_LIMIT;
+        }
+        s->activityInc /= CDCL_ACTIVITY_LIMIT;
+    }
+    if (s->heapPos[v] != -1){
+        cdclHeapUp(s, s->heapPos[v]);
+    }
+}
+
+/*
+ * This function adds the clause at offset clause of clauseLits to the clauses watching lit.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the clause was added.
+ */
+int cdclWatch(struct cdclSolver *s, int lit, int clause){
+    struct watchList *list = &(s->watches[lit]);
+    int *clauses;
+    if (list->size == list->capacity){
+        clauses = (int *)realloc(list->clauses, (2 * list->capacity + 4) * sizeof(int));
+        if (clauses == NULL){
+            return -1;
+        }
+        list->clauses = clauses;
+        list->capacity = 2 * list->capacity + 4;
+    }
+    list->clauses[list->size++] = clause;
+    return 0;
+}
+
+/*
+ * This function stores the clause of the given size (at least 2) in clauseLits,
+ * watching its first two literals.
+ * It returns the offset of the clause, or -1 if memory allocation failed.
+ */
+int cdclStoreClause(struct cdclSolver *s, int *lits, int size){
+    int i, clause = s->litsSize, *clauseLits;
+    if (s->litsSize + size + 1 > s->litsCapacity){
+        clauseLits = (int *)realloc(s->clauseLits, (2 * s->litsCapacity + size + 1) * sizeof(int));
+        if (clauseLits == NULL){
+            return -1;
+        }
+        s->clauseLits = clauseLits;
+        s->litsCapacity = 2 * s->litsCapacity + size + 1;
+    }
+    s->clauseLits[clause] = size;
+    for (i = 0; i < size; i++){
+        s->clauseLits[clause + 1 + i] = lits[i];
+    }
+    s->litsSize += size + 1;
+    if ((cdclWatch(s, lits[0], clause) == -1) || (cdclWatch(s, lits[1], clause) == -1)){
+        return -1;
+    }
+    return clause;
+}
+
+/*
+ * This method assigns lit to be true on the current decision level, implied by clause reason (or -1).
+ */
+void cdclAssign(struct cdclSolver *s, int lit, int reason){
+    int v = lit >> 1;
+    s->values[v] = (signed char)((lit & 1) ? -1 : 1);
+    s->levels[v] = s->numLevels;
+    s->reasons[v] = reason;
+    s->trail[s->trailSize++] = lit;
+}
+
+/*
+ * This method opens a new decision level.
+ */
+void cdclNewLevel(struct cdclSolver *s){
+    s->levelStart[s->numLevels++] = s->trailSize;
+}
+
+/*
+ * This method undoes every assignment made above the given decision level.
+ */
+void cdclBacktrack(struct cdclSolver *s, int level){
+    int i, v;
+    if (s->numLevels <= level){
+        return;
+    }
+    for (i = s->trailSize - 1; i >= s->levelStart[level]; i--){
+        v = s->trail[i] >> 1;
+        s->phases[v] = s->values[v];
+        s->values[v] = 0;
+        s->reasons[v] = -1;
+        cdclHeapInsert(s, v);
+    }
+    s->trailSize = s->propagated = s->levelStart[level];
+    s->numLevels = level;
+}
+
+/*
+ * This function propagates the literals assigned since the last propagation, through the watched literals.
+ * Return values:
+ * -2: memory allocation failed.
+ * -1: every clause still has a literal which is not false.
+ * The offset of a clause all literals of which are false otherwise.
+ */
+int cdclPropagate(struct cdclSolver *s){
+    int i, j, k, clause, falseLit, tmp, *lits;
+    struct watchList *list;
+    while (s->propagated < s->trailSize){
+        falseLit = s->trail[s->propagated++] ^ 1;
+        list = &(s->watches[falseLit]);
+        for (i = j = 0; i < list->size; i++){
+            clause = list->clauses[i];
+            lits = s->clauseLits + clause + 1;
+            if (lits[0] == falseLit){ /* the false watch is kept second */
+                lits[0] = lits[1];
+                lits[1] = falseLit;
+            }
+            if (cdclLitValue(s, lits[0]) == 1){
+                list->clauses[j++] = clause;
+                continue;
+            }
+            for (k = 2; k < lits[-1]; k++){
+                if (cdclLitValue(s, lits[k]) != -1){
+                    break;
+                }
+            }
+            if (k < lits[-1]){ /* another literal takes over the watch */
+                tmp = lits[1];
+                lits[1] = lits[k];
+                lits[k] = tmp;
+                if (cdclWatch(s, lits[1], clause) == -1){
+                    for (; i < list->size; i++){
+                        list->clauses[j++] = list->clauses[i];
+                    }
+                    list->size = j;
+                    return -2;
+                }
+                continue;
+            }
+            list->clauses[j++] = clause;
+            if (cdclLitValue(s, lits[0]) == -1){ /* a conflict */
+                for (i++; i < list->size; i++){
+                    list->clauses[j++] = list->clauses[i];
+                }
+                list->size = j;
+                s->propagated = s->trailSize;
+                return clause;
+            }
+            cdclAssign(s, lits[0], clause);
+        }
+        list->size = j;
+    }
+    return -1;
+}
+
+/*
+ * This function analyses the conflict of clause conflict into the first unique implication point,
+ * and leaves the clause learnt from it in s->learnt, the literal it asserts first
+ * and the literal of the highest level among the rest second.
+ * It returns the size of the learnt clause, and the level to go back to through *pLevel.
+ */
+int cdclAnalyze(struct cdclSolver *s, int conflict, int *pLevel){
+    int i, j, v, lit = -1, size = 1, open = 0, index = s->trailSize - 1, tmp, *lits;
+    do{
+        lits = s->clauseLits + conflict + 1;
+        for (j = (lit == -1) ? 0 : 1; j < lits[-1]; j++){ /* the first literal of a reason is the one it implied */
+            v = lits[j] >> 1;
+            if (!s->seen[v] && (s->levels[v] > 0)){
+                cdclBumpActivity(s, v);
+                s->seen[v] = 1;
+                if (s->levels[v] >= s->numLevels){
+                    open++;
+                }
+                else{
+                    s->learnt[size++] = lits[j];
+                }
+            }
+        }
+        while (!s->seen[s->trail[index] >> 1]){
+            index--;
+        }
+        lit = s->trail[index--];
+        conflict = s->reasons[lit >> 1];
+        s->seen[lit >> 1] = 0;
+        open--;
+    } while (open > 0);
+    s->learnt[0] = lit ^ 1;
+
+    *pLevel = 0;
+    for (i = 1; i < size; i++){
+        s->seen[s->learnt[i] >> 1] = 0;
+        if (s->levels[s->learnt[i] >> 1] > *pLevel){
+            *pLevel = s->levels[s->learnt[i] >> 1];
+            tmp = s->learnt[1];
+            s->learnt[1] = s->learnt[i];
+            s->learnt[i] = tmp;
+        }
+    }
+    return size;
+}
+
+/*
+ * This method drops every learnt clause, once they outgrow the formula. It is only called on level 0,
+ * where the assignments need no reasons.
+ */
+void cdclReduceLearnt(struct cdclSolver *s){
+    int i, j, lit;
+    struct watchList *list;
+    if (s->litsSize - s->formulaSize <= s->formulaSize + CDCL_MIN_LEARNT_LITS){
+        return;
+    }
+    for (lit = 0; lit < 2 * s->numVars; lit++){
+        list = &(s->watches[lit]);
+        for (i = j = 0; i < list->size; i++){
+            if (list->clauses[i] < s->formulaSize){
+                list->clauses[j++] = list->clauses[i];
+            }
+        }
+        list->size = j;
+    }
+    for (i = 0; i < s->trailSize; i++){
+        s->reasons[s->trail[i] >> 1] = -1;
+    }
+    s->litsSize = s->formulaSize;
+}
+
+/*
+ * This function initializes s with numVars variables and no clauses.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the solver was initialized successfully.
+ * User needs to call freeCdclSolver iff return value == 0.
+ */
+int initCdclSolver(struct cdclSolver *s, int numVars){
+    int v;
+    s->numVars = numVars;
+    s->numClauses = 0;
+    s->litsSize = s->formulaSize = 0;
+    s->litsCapacity = 1024;
+    s->trailSize = s->propagated = 0;
+    s->numLevels = 0;
+    s->activityInc = 1;
+    s->heapSize = numVars;
+    s->decisions = s->conflicts = 0;
+    s->unsatisfiable = 0;
+    s->clauseLits = (int *)malloc(s->litsCapacity * sizeof(int));
+    s->watches = (struct watchList *)calloc(2 * numVars, sizeof(struct watchList));
+    s->values = (signed char *)calloc(numVars, sizeof(signed char));
+    s->phases = (signed char *)calloc(numVars, sizeof(signed char));
+    s->levels = (int *)calloc(numVars, sizeof(int));
+    s->reasons = (int *)malloc(numVars * sizeof(int));
+    s->trail = (int *)malloc(numVars * sizeof(int));
+    s->levelStart = (int *)malloc((numVars + 1) * sizeof(int));
+    s->activity = (double *)calloc(numVars, sizeof(double));
+    s->heap = (int *)malloc(numVars * sizeof(int));
+    s->heapPos = (int *)malloc(numVars * sizeof(int));
+    s->seen = (char *)calloc(numVars, sizeof(char));
+    s->learnt = (int *)malloc((numVars + 1) * sizeof(int));
+    if ((s->clauseLits == NULL) || (s->watches == NULL) || (s->values == NULL) || (s->phases == NULL)
+        || (s->levels == NULL) || (s->reasons == NULL) || (s->trail == NULL) || (s->levelStart == NULL)
+        || (s->activity == NULL) || (s->heap == NULL) || (s->heapPos == NULL) || (s->seen == NULL)
+        || (s->learnt == NULL)){
+        freeCdclSolver(s);
+        return -1;
+    }
+    for (v = 0; v < numVars; v++){
+        s->reasons[v] = -1;
+        s->heap[v] = v;
+        s->heapPos[v] = v;
+    }
+    return 0;
+}
+
+/*
+ * This function frees all memory owned by s.
+ */
+void freeCdclSolver(struct cdclSolver *s){
+    int lit;
+    if (s->watches != NULL){
+        for (lit = 0; lit < 2 * s->numVars; lit++){
+            free(s->watches[lit].clauses);
+        }
+    }
+    free(s->clauseLits);
+    free(s->watches);
+    free(s->values);
+    free(s->phases);
+    free(s->levels);
+    free(s->reasons);
+    free(s->trail);
+    free(s->levelStart);
+    free(s->activity);
+    free(s->heap);
+    free(s->heapPos);
+    free(s->seen);
+    free(s->learnt);
+    s->clauseLits = NULL;
+    s->watches = NULL;
+    s->values = s->phases = NULL;
+    s->levels = s->reasons = s->trail = s->levelStart = NULL;
+    s->activity = NULL;
+    s->heap = s->heapPos = NULL;
+    s->seen = NULL;
+    s->learnt = NULL;
+}
+
+/*
+ * This function adds the clause of the given size to the formula of s.
+ * All clauses need to be added before the first solve.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the clause was added.
+ */
+int addCdclClause(struct cdclSolver *s, int *lits, int size){
+    if (size == 0){
+        s->unsatisfiable = 1;
+        return 0;
+    }
+    if (size == 1){ /* a fact, which holds on level 0 */
+        if (cdclLitValue(s, lits[0]) == -1){
+            s->unsatisfiable = 1;
+        }
+        else if (cdclLitValue(s, lits[0]) == 0){
+            cdclAssign(s, lits[0], -1);
+        }
+        return 0;
+    }
+    if (cdclStoreClause(s, lits, size) == -1){
+        return -1;
+    }
+    s->formulaSize = s->litsSize;
+    s->numClauses++;
+    return 0;
+}
+
+/*
+ * This function solves the formula of s, under the given assumptions.
+ * Every decision is charged to the budget of the command as a node,
+ * and the solve gives up once *stop is set by another thread (unless stop == NULL).
+ * The assumptions are decided first, a level each (an assumption which already holds gets an empty level),
+ * so a learnt clause which sends the search back among them makes the solve try them again.
+ * Return values:
+ * -4: the budget of the command ran out.
+ * -3: the solve was stopped.
+ * -1: memory allocation failed, and s can only be freed.
+ *  0: the formula can not be satisfied under the assumptions.
+ *  1: the formula was satisfied, and cdclValue tells how until the next solve.
+ */
+int solveCdcl(struct cdclSolver *s, int *assumptions, int numAssumptions, volatile int *stop){
+    int v, lit, level, size, clause, res = -2, restarts = 0, *levelStart;
+    long conflictsLeft = cdclLuby(0) * CDCL_RESTART_CONFLICTS, nodes = 0;
+
+    if (s->unsatisfiable){
+        return 0;
+    }
+    levelStart = (int *)realloc(s->levelStart, (s->numVars + numAssumptions + 1) * sizeof(int));
+    if (levelStart == NULL){
+        return -1;
+    }
+    s->levelStart = levelStart;
+    cdclBacktrack(s, 0);
+    cdclReduceLearnt(s);
+    while (res == -2){
+        clause = cdclPropagate(s);
+        if (clause == -2){
+            res = -1;
+        }
+        else if (clause >= 0){
+            s->conflicts++;
+            conflictsLeft--;
+            if (s->numLevels == 0){ /* the formula itself can not be satisfied */
+                s->unsatisfiable = 1;
+                res = 0;
+                continue;
+            }
+            size = cdclAnalyze(s, clause, &level);
+            cdclBacktrack(s, level);
+            if (size == 1){
+                cdclAssign(s, s->learnt[0], -1);
+            }
+            else{
+                clause = cdclStoreClause(s, s->learnt, size);
+                if (clause == -1){
+                    res = -1;
+                    continue;
+                }
+                cdclAssign(s, s->learnt[0], clause);
+            }
+            s->activityInc /= CDCL_ACTIVITY_DECAY;
+        }
+        else if (conflictsLeft <= 0){
+            cdclBacktrack(s, 0);
+            cdclReduceLearnt(s);
+            conflictsLeft = cdclLuby(++restarts) * CDCL_RESTART_CONFLICTS;
+        }
+        else if ((stop != NULL) && *stop){
+            res = -3;
+        }
+        else if (s->numLevels < numAssumptions){
+            lit = assumptions[s->numLevels];
+            if (cdclLitValue(s, lit) == -1){ /* the assumptions contradict each other, or the formula */
+                res = 0;
+                continue;
+            }
+            cdclNewLevel(s);
+            if (cdclLitValue(s, lit) == 0){
+                cdclAssign(s, lit, -1);
+            }
+        }
+        else{
+            do{
+                v = cdclHeapPop(s);
+            } while ((v != -1) && (s->values[v] != 0));
+            if (v == -1){ /* every variable is assigned */
+                res = 1;
+                continue;
+            }
+            s->decisions++;
+            if ((++nodes % BUDGET_POLL_NODES) == 0){
+                chargeBudget(nodeBudget, BUDGET_POLL_NODES);
+                if (budgetExhausted()){
+                    cdclHeapInsert(s, v);
+                    res = -4;
+                    continue;
+                }
+            }
+            cdclNewLevel(s);
+            cdclAssign(s, CDCL_LIT(v, s->phases[v] == 1), -1);
+        }
+    }
+    chargeBudget(nodeBudget, nodes % BUDGET_POLL_NODES);
+    return res;
+}
+
+/*
+ * This method returns 1 if variable v is true in the assignment the last solve found, and 0 otherwise.
+ */
+int cdclValue(struct cdclSolver *s, int v){
+    return s->values[v] == 1;
+}
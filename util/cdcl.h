@@ -0,0 +1,98 @@
+/*
+ * This module deals with everything that has to do with the cdclSolver struct.
+ * A CDCL solver decides whether a formula in conjunctive normal form can be satisfied:
+ * it propagates with two watched literals per clause, learns a clause from every conflict,
+ * picks its decisions by the activity of the variables in recent conflicts, and restarts
+ * on the Luby sequence.
+ * The formula is solved under assumptions, literals which hold for a single solve only,
+ * so the clauses it learnt keep helping the solves which follow with other assumptions.
+ */
+
+#ifndef SOFTWAREPROJECTFINALPROJECT_CDCL_H
+#define SOFTWAREPROJECTFINALPROJECT_CDCL_H
+
+/*
+ * Variables are numbered from 0. Literal 2 * v is variable v, and literal 2 * v + 1 is its negation.
+ */
+#define CDCL_LIT(v, positive) (2 * (v) + ((positive) ? 0 : 1))
+
+/*
+ * The clauses that watch a literal.
+ */
+struct watchList {
+    int *clauses; /* offsets of the clauses in clauseLits */
+    int size;
+    int capacity;
+};
+
+struct cdclSolver {
+    int numVars;
+    int numClauses; /* the clauses of the formula, the learnt ones not included */
+    int *clauseLits; /* every clause is its size followed by its literals, the two watched ones first */
+    int litsSize;
+    int litsCapacity;
+    int formulaSize; /* the clauses from clauseLits[formulaSize] on are learnt */
+    struct watchList *watches; /* one per literal */
+    signed char *values; /* 1, -1 or 0 (unassigned) for every variable */
+    signed char *phases; /* the value every variable had last, which decisions reuse */
+    int *levels;
+    int *reasons; /* the clause which implied every variable, or -1 */
+    int *trail; /* the assigned literals, in the order they were assigned */
+    int trailSize;
+    int propagated; /* trail[0..propagated - 1] were propagated */
+    int *levelStart; /* where every decision level starts in trail */
+    int numLevels;
+    double *activity;
+    double activityInc;
+    int *heap; /* the variables, as a binary heap by activity */
+    int *heapPos; /* the position of every variable in heap, or -1 */
+    int heapSize;
+    char *seen; /* scratch for the conflict analysis */
+    int *learnt; /* scratch for the conflict analysis */
+    long decisions;
+    long conflicts;
+    int unsatisfiable; /* 1 once the formula itself was found unsatisfiable */
+};
+
+/*
+ * This function initializes s with numVars variables and no clauses.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the solver was initialized successfully.
+ * User needs to call freeCdclSolver iff return value == 0.
+ */
+int initCdclSolver(struct cdclSolver *s, int numVars);
+
+/*
+ * This function frees all memory owned by s.
+ */
+void freeCdclSolver(struct cdclSolver *s);
+
+/*
+ * This function adds the clause of the given size to the formula of s.
+ * All clauses need to be added before the first solve.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the clause was added.
+ */
+int addCdclClause(struct cdclSolver *s, int *lits, int size);
+
+/*
+ * This function solves the formula of s, under the given assumptions.
+ * Every decision is charged to the budget of the command as a node,
+ * and the solve gives up once *stop is set by another thread (unless stop == NULL).
+ * Return values:
+ * -4: the budget of the command ran out.
+ * -3: the solve was stopped.
+ * -1: memory allocation failed, and s can only be freed.
+ *  0: the formula can not be satisfied under the assumptions.
+ *  1: the formula was satisfied, and cdclValue tells how until the next solve.
+ */
+int solveCdcl(struct cdclSolver *s, int *assumptions, int numAssumptions, volatile int *stop);
+
+/*
+ * This method returns 1 if variable v is true in the assignment the last solve found, and 0 otherwise.
+ */
+int cdclValue(struct cdclSolver *s, int v);
+
+#endif
@@ -0,0 +1,279 @@
+/*
+ * This module deals with everything that has to do with the movesList struct.
+ * The moves list is the undo/redo history of a board: every change of a cell is a move, and the moves
+ * of a single command are a batch, which undo and redo apply as a whole.
+ * The moves are kept in one growable array, in the order they were made, and the batches are kept
+ * as the positions their moves end at, so a batch is a range of the moves array.
+ * Every time as many moves as the board has cells are made, the board is kept as a snapshot, so the
+ * snapshots take about as much memory as the moves, and copying one costs about as much as replaying them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "moves_list.h"
+#include "../main_aux.h"
+
+/*
+ * This method initializes list to an empty history.
+ * Requires: list != NULL.
+ */
+void initMovesList(struct movesList *list){
+    list->moves = NULL;
+    list->numMoves = 0;
+    list->movesCapacity = 0;
+    list->batchEnds = NULL;
+    list->numBatches = 0;
+    list->batchesCapacity = 0;
+    list->current = 0;
+    list->snapshots = NULL;
+    list->snapshotBatches = NULL;
+    list->numSnapshots = 0;
+    list->snapshotsCapacity = 0;
+}
+
+/*
+ * This function frees list and its moves.
+ */
+void freeMovesList(struct movesList *list){
+    if (list != NULL){
+        free(list->moves);
+        free(list->batchEnds);
+        free(list->snapshots);
+        free(list->snapshotBatches);
+    }
+    free(list);
+}
+
+/*
+ * This method returns the position in the moves array of the first move of batch number batch of list,
+ * which is the number of moves of the batches before it.
+ */
+int batchStart(struct movesList *list, int batch){
+    return (batch == 0) ? 0 : list->batchEnds[batch - 1];
+}
+
+/*
+ * This method returns the moves of batch number batch of list, and their amount through *pCount.
+ */
+struct move *batchMoves(struct movesList *list, int batch, int *pCount){
+    *pCount = list->batchEnds[batch] - batchStart(list, batch);
+    return list->moves + batchStart(list, batch);
+}
+
+/*
+ * This function destroys all the next moves the user have done, so they can not be redone.
+ * It only forgets them, so it takes the same time however many moves there are.
+ */
+void killNextMoves(struct sudokuManager *board){
+    struct movesList *list = board->movesList;
+    if (list->numBatches > list->current){
+        list->numBatches = list->current;
+        list->numMoves = batchStart(list, list->current);
+        while ((list->numSnapshots > 0) && (list->snapshotBatches[list->numSnapshots - 1] > list->current)){
+            list->numSnapshots--;
+        }
+    }
+}
+
+/*
+ * This function adds the move of cell <row, col> from prevVal to newVal to the batch being made.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the move has been added successfully.
+ */
+int addMove(struct sudokuManager *board, int row, int col, int prevVal, int newVal){
+    struct movesList *list = board->movesList;
+    struct move *moves;
+    killNextMoves(board);
+    if (list->numMoves == list->movesCapacity){
+        moves = (struct move *)realloc(list->moves, (2 * list->movesCapacity + 16) * sizeof(struct move));
+        if (moves == NULL){
+            return -1;
+        }
+        list->moves = moves;
+        list->movesCapacity = 2 * list->movesCapacity + 16;
+    }
+    list->moves[list->numMoves].row = row;
+    list->moves[list->numMoves].col = col;
+    list->moves[list->numMoves].prevValue = prevVal;
+    list->moves[list->numMoves].newValue = newVal;
+    list->numMoves++;
+    return 0;
+}
+
+/*
+ * This function keeps the board as a snapshot of the board after the first batch batches.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the snapshot has been added successfully.
+ */
+int addSnapshot(struct sudokuManager *board, int batch){
+    struct movesList *list = board->movesList;
+    int area = boardArea(board), capacity = 2 * list->snapshotsCapacity + 4, *snapshots, *snapshotBatches;
+    if (list->numSnapshots == list->snapshotsCapacity){
+        snapshots = (int *)realloc(list->snapshots, capacity * area * sizeof(int));
+        if (snapshots == NULL){
+            return -1;
+        }
+        list->snapshots = snapshots;
+        snapshotBatches = (int *)realloc(list->snapshotBatches, capacity * sizeof(int));
+        if (snapshotBatches == NULL){
+            return -1;
+        }
+        list->snapshotBatches = snapshotBatches;
+        list->snapshotsCapacity = capacity;
+    }
+    memcpy(list->snapshots + list->numSnapshots * area, board->board, area * sizeof(int));
+    list->snapshotBatches[list->numSnapshots++] = batch;
+    return 0;
+}
+
+/*
+ * This function ends the batch being made, after the last move of the command.
+ * The first batch ever ended keeps the board before it as the first snapshot, by taking back its moves.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the batch has been ended successfully.
+ */
+int endMovesBatch(struct sudokuManager *board){
+    struct movesList *list = board->movesList;
+    int *batchEnds, *first, k, lastSnapshot;
+    killNextMoves(board);
+    if (list->numSnapshots == 0){
+        if (addSnapshot(board, 0) == -1){
+            return -1;
+        }
+        first = list->snapshots;
+        for (k = list->numMoves - 1; k >= 0; k--){
+            first[matIndex(board->m, board->n, list->moves[k].row, list->moves[k].col)] = list->moves[k].prevValue;
+        }
+    }
+    if (list->numBatches == list->batchesCapacity){
+        batchEnds = (int *)realloc(list->batchEnds, (2 * list->batchesCapacity + 16) * sizeof(int));
+        if (batchEnds == NULL){
+            return -1;
+        }
+        list->batchEnds = batchEnds;
+        list->batchesCapacity = 2 * list->batchesCapacity + 16;
+    }
+    list->batchEnds[list->numBatches++] = list->numMoves;
+    list->current = list->numBatches;
+    lastSnapshot = list->snapshotBatches[list->numSnapshots - 1];
+    if (list->numMoves - batchStart(list, lastSnapshot) >= boardArea(board)){
+        return addSnapshot(board, list->numBatches);
+    }
+    return 0;
+}
+
+/*
+ * This function restores the board of snapshot number snapshot.
+ */
+void restoreSnapshot(struct sudokuManager *board, int snapshot){
+    struct movesList *list = board->movesList;
+    int area = boardArea(board), *cells = list->snapshots + snapshot * area, i;
+    for (i = 0; i < area; i++){
+        if (board->board[i] != cells[i]){
+            updateEmptyCellsSingleSet(board, board->board[i], cells[i]);
+            board->board[i] = cells[i];
+        }
+    }
+    list->current = list->snapshotBatches[snapshot];
+    markBoardChanged(board);
+}
+
+/*
+ * This function brings the board to the state after the first batch batches, without printing the moves.
+ * It either undoes or redoes the batches between the current one and batch, or restores the nearest snapshot
+ * before batch and redoes the batches after it, whichever changes less cells.
+ * Requires: 0 <= batch <= board->movesList->numBatches.
+ */
+void goToBatch(struct sudokuManager *board, int batch){
+    struct movesList *list = board->movesList;
+    int low = 0, high = list->numSnapshots - 1, middle, replayed, fromSnapshot;
+    replayed = batchStart(list, batch) - batchStart(list, list->current);
+    if (replayed < 0){
+        replayed = -replayed;
+    }
+    if (list->numSnapshots > 0){
+        while (low < high){ /* the last snapshot at or before batch */
+            middle = (low + high + 1) / 2;
+            if (list->snapshotBatches[middle] <= batch){
+                low = middle;
+            }
+            else {
+                high = middle - 1;
+            }
+        }
+        fromSnapshot = boardArea(board) + batchStart(list, batch) - batchStart(list, list->snapshotBatches[low]);
+        if (fromSnapshot < replayed){
+            restoreSnapshot(board, low);
+        }
+    }
+    while (list->current > batch){
+        undoCommand(board, 0);
+    }
+    while (list->current < batch){
+        redoCommand(board, 0);
+    }
+}
+
+/*
+ * This function updates the board to the previous command,
+ * assumes board->movesList->current > 0
+ * It returns the number of the cells we changed.
+ */
+int undoCommand (struct sudokuManager *board, int isToPrint) {
+    int m = board->m, n = board->n, k, count;
+    struct move *moves = batchMoves(board->movesList, --board->movesList->current, &count);
+    for (k = count - 1; k >= 0; k--) { /* the moves of the batch, from the last one made */
+        changeCellValue(board->board, m, n, moves[k].row, moves[k].col, moves[k].prevValue);
+        updateEmptyCellsSingleSet(board, moves[k].newValue, moves[k].prevValue);
+        if(isToPrint){
+            printActionWasMade(moves[k].row, moves[k].col, moves[k].newValue, moves[k].prevValue);
+        }
+    }
+    markBoardChanged(board);
+    return count;
+}
+
+/*
+ * This function updates the board to the next command,
+ * assumes board->movesList->current < board->movesList->numBatches
+ * Return values: returns the number of cells we changed.
+ */
+int redoCommand (struct sudokuManager *board, int isToPrint){
+    int m = board->m, n = board->n, k, count;
+    struct move *moves = batchMoves(board->movesList, board->movesList->current++, &count);
+    for (k = 0; k < count; k++) {
+        changeCellValue(board->board, m, n, moves[k].row, moves[k].col, moves[k].newValue);
+        updateEmptyCellsSingleSet(board, moves[k].prevValue, moves[k].newValue);
+        if(isToPrint){
+            printActionWasMade(moves[k].row, moves[k].col, moves[k].prevValue, moves[k].newValue);
+        }
+    }
+    markBoardChanged(board);
+    return count;
+}
+
+/*
+ * This function will update the list of the board after "generate" and "guess".
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: update succeeded.
+ */
+int updateBoardMovesList(struct sudokuManager *manager, int *retBoard){
+    int row, col, length = boardLen(manager), index;
+    int m = manager->m, n = manager->n;
+    for(row = 0; row < length; row++){
+        for(col = 0; col < length; col++){
+            index = matIndex(m, n, row, col);
+            if(manager->board[index] != retBoard[index]){
+                if(doSet(manager, row, col, retBoard[index]) == -1){
+                    return -1;
+                }
+            }
+        }
+    }
+    return endMovesBatch(manager);
+}
@@ -0,0 +1,113 @@
+/*
+ * This module deals with everything that has to do with the movesList struct.
+ * The moves list is the undo/redo history of a board: every change of a cell is a move, and the moves
+ * of a single command are a batch, which undo and redo apply as a whole.
+ * The moves are kept in one growable array, in the order they were made, and the batches are kept
+ * as the positions their moves end at, so a batch is a range of the moves array.
+ * Every time as many moves as the board has cells are made, the board is kept as a snapshot,
+ * so jumping to any batch restores the nearest snapshot before it and replays only the moves after it.
+ */
+
+#ifndef SOFTWAREPROJECTFINALPROJECT_MOVES_LIST_H
+#define SOFTWAREPROJECTFINALPROJECT_MOVES_LIST_H
+
+#include "board_manager.h"
+
+struct sudokuManager;
+
+struct move {
+    int row;
+    int col;
+    int prevValue;
+    int newValue;
+};
+
+struct movesList {
+    struct move *moves; /* the moves of every batch, and then the moves of the batch being made */
+    int numMoves;
+    int movesCapacity;
+    int *batchEnds; /* the moves of batch b are moves[batchEnds[b - 1]..batchEnds[b] - 1] (from 0 for b == 0) */
+    int numBatches;
+    int batchesCapacity;
+    int current; /* the number of batches applied to the board, the ones after it can be redone */
+    int *snapshots; /* numSnapshots boards, the one of snapshot s is the board after snapshotBatches[s] batches */
+    int *snapshotBatches; /* increasing, and snapshotBatches[0] == 0 once there is a batch */
+    int numSnapshots;
+    int snapshotsCapacity;
+};
+
+/*
+ * This method initializes list to an empty history.
+ * Requires: list != NULL.
+ */
+void initMovesList(struct movesList *list);
+
+/*
+ * This function frees list and its moves.
+ */
+void freeMovesList(struct movesList *list);
+
+/*
+ * This function destroys all the next moves the user have done, so they can not be redone.
+ * It only forgets them, so it takes the same time however many moves there are.
+ */
+void killNextMoves(struct sudokuManager *board);
+
+/*
+ * This function adds the move of cell <row, col> from prevVal to newVal to the batch being made.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the move has been added successfully.
+ */
+int addMove(struct sudokuManager *board, int row, int col, int prevVal, int newVal);
+
+/*
+ * This function ends the batch being made, after the last move of the command.
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: the batch has been ended successfully.
+ */
+int endMovesBatch(struct sudokuManager *board);
+
+/*
+ * This method returns the position in the moves array of the first move of batch number batch of list,
+ * which is the number of moves of the batches before it.
+ */
+int batchStart(struct movesList *list, int batch);
+
+/*
+ * This method returns the moves of batch number batch of list, and their amount through *pCount.
+ */
+struct move *batchMoves(struct movesList *list, int batch, int *pCount);
+
+/*
+ * This function brings the board to the state after the first batch batches, without printing the moves.
+ * It either undoes or redoes the batches between the current one and batch, or restores the nearest snapshot
+ * before batch and redoes the batches after it, whichever changes less cells.
+ * Requires: 0 <= batch <= board->movesList->numBatches.
+ */
+void goToBatch(struct sudokuManager *board, int batch);
+
+/*
+ * This function updates the board to the previous command,
+ * assumes board->movesList->current > 0
+ * Return values: returns the number of cells we changed.
+ */
+int undoCommand (struct sudokuManager *board, int isToPrint);
+
+/*
+ * This function updates the board to the next command,
+ * assumes board->movesList->current < board->movesList->numBatches
+ * Return values: returns the number of cells we changed.
+ */
+int redoCommand (struct sudokuManager *board, int isToPrint);
+
+/*
+ * This function will update the list of the board after "generate" and "guess".
+ * Return values:
+ * -1: memory allocation failed.
+ *  0: update succeeded.
+ */
+int updateBoardMovesList(struct sudokuManager *manager, int *retBoard);
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * This module deals with everything that has to do with the randomStream struct.
+ * A random stream is a pseudo random generator (xoshiro128**) with a state of its own,
+ * so streams drawn on different threads do not disturb each other, and a stream seeded
+ * with the same seed and stream number always draws the same numbers.
+ * Everything is computed on the low 32 bits of unsigned long, which is at least that wide.
+ */
+
+#include <time.h>
+#include "random.h"
+
+#define MASK32 0xFFFFFFFFUL
+#define GOLDEN_GAMMA 0x9E3779B9UL /* the seeding steps, 2^32 divided by the golden ratio */
+
+static struct randomStream session;
+static int sessionSeeded = 0;
+static unsigned long lastSessionSeed = 0;
+
+/*
+ * This method returns x rotated left by k bits, as a 32 bits number.
+ */
+unsigned long rotateLeft32(unsigned long x, int k){
+    return ((x << k) | (x >> (32 - k))) & MASK32;
+}
+
+/*
+ * This method scrambles the bits of x (the finalizer of MurmurHash3), as a 32 bits number.
+ */
+unsigned long mix32(unsigned long x){
+    x &= MASK32;
+    x = ((x ^ (x >> 16)) * 0x85EBCA6BUL) & MASK32;
+    x = ((x ^ (x >> 13)) * 0xC2B2AE35UL) & MASK32;
+    return x ^ (x >> 16);
+}
+
+/*
+ * This function seeds random with seed, as stream number stream of that seed.
+ * Different stream numbers of the same seed draw unrelated numbers.
+ */
+void seedRandom(struct randomStream *random, unsigned long seed, unsigned long stream){
+    int i;
+    unsigned long x = (mix32(seed) ^ mix32(stream * GOLDEN_GAMMA + 1)) & MASK32;
+    for (i = 0; i < 4; i++){
+        x = (x + GOLDEN_GAMMA) & MASK32;
+        random->state[i] = mix32(x);
+    }
+    if ((random->state[0] | random->state[1] | random->state[2] | random->state[3]) == 0){
+        random->state[0] = 1; /* the only state the generator can not leave */
+    }
+}
+
+/*
+ * This method draws the next 32 bits of random.
+ */
+unsigned long nextRandom(struct randomStream *random){
+    unsigned long *s = random->state;
+    unsigned long result = (rotateLeft32((s[1] * 5) & MASK32, 7) * 9) & MASK32;
+    unsigned long t = (s[1] << 9) & MASK32;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotateLeft32(s[3], 11);
+    return result;
+}
+
+/*
+ * This method draws an integer between 0 and bound - 1 from random, all of them equally likely.
+ */
+int randomBelow(struct randomStream *random, int bound){
+    unsigned long x, b = (unsigned long)bound;
+    unsigned long threshold = ((MASK32 - b + 1) & MASK32) % b; /* 2^32 mod bound, the draws that would bias */
+    do{
+        x = nextRandom(random);
+    } while (x < threshold);
+    return (int)(x % b);
+}
+
+/*
+ * This method draws a number between 0 (included) and 1 (excluded) from random.
+ */
+double randomUnit(struct randomStream *random){
+    return (double)nextRandom(random) / ((double)MASK32 + 1.0);
+}
+
+/*
+ * This function seeds the stream the commands of the session draw from with seed,
+ * so the commands after it draw the same numbers every time.
+ */
+void seedSession(unsigned long seed){
+    seedRandom(&session, seed, 0);
+    lastSessionSeed = seed;
+    sessionSeeded = 1;
+}
+
+/*
+ * This method returns the stream the commands of the session draw from,
+ * seeded from the clock on first use.
+ */
+struct randomStream *sessionRandom(){
+    if (!sessionSeeded){
+        seedSession((unsigned long)time(NULL) & MASK32);
+    }
+    return &session;
+}
+
+/*
+ * This method returns the seed the stream of the session was last seeded with.
+ */
+unsigned long sessionSeed(){
+    sessionRandom(); /* the seed from the clock, if it was not seeded yet */
+    return lastSessionSeed;
+}
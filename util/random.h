@@ -0,0 +1,53 @@
+/*
+ * This module deals with everything that has to do with the randomStream struct.
+ * A random stream is a pseudo random generator (xoshiro128**) with a state of its own,
+ * so streams drawn on different threads do not disturb each other, and a stream seeded
+ * with the same seed and stream number always draws the same numbers.
+ */
+
+#ifndef SOFTWAREPROJECTFINALPROJECT_RANDOM_H
+#define SOFTWAREPROJECTFINALPROJECT_RANDOM_H
+
+struct randomStream {
+    unsigned long state[4]; /* 32 bits each */
+};
+
+/*
+ * This function seeds random with seed, as stream number stream of that seed.
+ * Different stream numbers of the same seed draw unrelated numbers.
+ */
+void seedRandom(struct randomStream *random, unsigned long seed, unsigned long stream);
+
+/*
+ * This method draws the next 32 bits of random.
+ */
+unsigned long nextRandom(struct randomStream *random);
+
+/*
+ * This method draws an integer between 0 and bound - 1 from random, all of them equally likely.
+ */
+int randomBelow(struct randomStream *random, int bound);
+
+/*
+ * This method draws a number between 0 (included) and 1 (excluded) from random.
+ */
+double randomUnit(struct randomStream *random);
+
+/*
+ * This method returns the stream the commands of the session draw from,
+ * seeded from the clock on first use.
+ */
+struct randomStream *sessionRandom();
+
+/*
+ * This function seeds the stream the commands of the session draw from with seed,
+ * so the commands after it draw the same numbers every time.
+ */
+void seedSession(unsigned long seed);
+
+/*
+ * This method returns the seed the stream of the session was last seeded with.
+ */
+unsigned long sessionSeed();
+
+#endif
@@ -0,0 +1,170 @@
+/*
+ * This module records what every call to a solver cost: the size of its model,
+ * and the time it spent in each of its phases.
+ * It keeps totals per solver for the solver_stats command, and can also write every call
+ * as a line of a log file, and have the Gurobi models exported to a file before they are optimized.
+ * The race backend and generate_batch solve on several threads at once, so the records are kept under a lock.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "solver_stats.h"
+#include "budget.h"
+
+static pthread_mutex_t statsLock = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK_STATS() pthread_mutex_lock(&statsLock)
+#define UNLOCK_STATS() pthread_mutex_unlock(&statsLock)
+
+#define OUTPUT_PATH_LENGTH 256
+
+static struct solverTotals totals[NUM_SOLVER_KINDS];
+static FILE *solverLog = NULL;
+static char logPath[OUTPUT_PATH_LENGTH]; /* empty if there is no log */
+static char exportPath[OUTPUT_PATH_LENGTH]; /* empty if the models are not written */
+
+static char *kindNames[NUM_SOLVER_KINDS] = {"gurobi_ilp", "gurobi_lp", "native_search", "native_lp", "sat_cdcl"};
+
+/*
+ * This function starts call, a call of the given kind over an m*n board, with no time spent yet.
+ */
+void startSolverCall(struct solverCall *call, enum solverKind kind, int m, int n){
+    int phase;
+    call->kind = kind;
+    call->m = m;
+    call->n = n;
+    call->numVars = 0;
+    call->numConstrs = 0;
+    for (phase = 0; phase < NUM_SOLVER_PHASES; phase++){
+        call->seconds[phase] = 0;
+    }
+    call->result = 0;
+}
+
+/*
+ * This function adds the time passed since since (on the monotonic clock of util/budget.h)
+ * to the given phase of call.
+ */
+void endSolverPhase(struct solverCall *call, enum solverPhase phase, double since){
+    call->seconds[phase] += monotonicSeconds() - since;
+}
+
+/*
+ * This function records call, which returned result, and writes it to the log if there is one.
+ */
+void recordSolverCall(struct solverCall *call, int result){
+    int phase;
+    struct solverTotals *t = &totals[call->kind];
+    call->result = result;
+    LOCK_STATS();
+    t->calls++;
+    t->vars += call->numVars;
+    t->constrs += call->numConstrs;
+    for (phase = 0; phase < NUM_SOLVER_PHASES; phase++){
+        t->seconds[phase] += call->seconds[phase];
+    }
+    t->last = *call;
+    if (solverLog != NULL){
+        fprintf(solverLog, "%s,%d,%d,%d,%d,%.6f,%.6f,%.6f,%.6f,%d\n", kindNames[call->kind],
+                call->m, call->n, call->numVars, call->numConstrs, call->seconds[indexPhase],
+                call->seconds[modelPhase], call->seconds[optimizePhase], call->seconds[decodePhase], result);
+        fflush(solverLog);
+    }
+    UNLOCK_STATS();
+}
+
+/*
+ * This function records a call to the solver of the given kind which was answered from its cache.
+ */
+void recordCachedSolverCall(enum solverKind kind){
+    LOCK_STATS();
+    totals[kind].cachedCalls++;
+    UNLOCK_STATS();
+}
+
+/*
+ * This method returns the totals of the solver of the given kind.
+ */
+struct solverTotals *solverStatistics(enum solverKind kind){
+    return &totals[kind];
+}
+
+/*
+ * This method returns the name of the solver of the given kind.
+ */
+char *solverKindName(enum solverKind kind){
+    return kindNames[kind];
+}
+
+/*
+ * This function starts writing every call to the file at path, as a line of comma separated values,
+ * after a header line. Any previous log is closed. If path == NULL, the log is only closed.
+ * It returns -1 if the file could not be opened, and 0 otherwise.
+ */
+int setSolverLog(char *path){
+    FILE *file = NULL;
+    if (path != NULL){
+        if (strlen(path) >= OUTPUT_PATH_LENGTH){
+            return -1;
+        }
+        file = fopen(path, "w");
+        if (file == NULL){
+            return -1;
+        }
+        fprintf(file, "solver,m,n,vars,constrs,index_s,model_s,optimize_s,decode_s,result\n");
+    }
+    LOCK_STATS();
+    if (solverLog != NULL){
+        fclose(solverLog);
+    }
+    solverLog = file;
+    if (path == NULL){
+        logPath[0] = '\0';
+    }
+    else{
+        strcpy(logPath, path);
+    }
+    UNLOCK_STATS();
+    return 0;
+}
+
+/*
+ * This method returns the file every call is written to, or NULL if there is no log.
+ */
+char *solverLogPath(){
+    return (logPath[0] == '\0') ? NULL : logPath;
+}
+
+/*
+ * This function sets the file every Gurobi model is written to before it is optimized,
+ * in a format the extension of path tells (e.g. ".lp" or ".mps").
+ * If path == NULL, the models are not written.
+ * It returns -1 if path is too long, and 0 otherwise.
+ */
+int setModelExport(char *path){
+    if (path == NULL){
+        exportPath[0] = '\0';
+        return 0;
+    }
+    if (strlen(path) >= OUTPUT_PATH_LENGTH){
+        return -1;
+    }
+    strcpy(exportPath, path);
+    return 0;
+}
+
+/*
+ * This method returns the file every Gurobi model is written to before it is optimized,
+ * or NULL if the models are not written.
+ */
+char *modelExportPath(){
+    return (exportPath[0] == '\0') ? NULL : exportPath;
+}
+
+/*
+ * This function closes the log, and stops exporting the models.
+ */
+void releaseSolverStatistics(){
+    setSolverLog(NULL);
+    setModelExport(NULL);
+}
@@ -0,0 +1,119 @@
+/*
+ * This module records what every call to a solver cost: the size of its model,
+ * and the time it spent in each of its phases.
+ * It keeps totals per solver for the solver_stats command, and can also write every call
+ * as a line of a log file, and have the Gurobi models exported to a file before they are optimized.
+ */
+
+#ifndef SOFTWAREPROJECTFINALPROJECT_SOLVER_STATS_H
+#define SOFTWAREPROJECTFINALPROJECT_SOLVER_STATS_H
+
+enum solverKind {
+    ilpSolver = 0, /* the Gurobi ILP */
+    lpSolver = 1, /* the Gurobi LP */
+    nativeSearchSolver = 2,
+    nativeLPSolver = 3,
+    satSolver = 4
+};
+
+#define NUM_SOLVER_KINDS 5
+
+enum solverPhase {
+    indexPhase = 0, /* finding the candidates of the board */
+    modelPhase = 1, /* building or updating the variables and constraints */
+    optimizePhase = 2,
+    decodePhase = 3 /* turning the solution into a board or scores */
+};
+
+#define NUM_SOLVER_PHASES 4
+
+/*
+ * A single call to a solver, over an m*n board.
+ * The native search has no constraints, and its variables are the empty cells.
+ * The constraints of the SAT solver are the clauses of its formula, the learnt ones not included.
+ */
+struct solverCall {
+    enum solverKind kind;
+    int m;
+    int n;
+    int numVars;
+    int numConstrs;
+    double seconds[NUM_SOLVER_PHASES];
+    int result; /* the return value of the call */
+};
+
+/*
+ * The calls to one solver since the session started.
+ */
+struct solverTotals {
+    long calls;
+    long cachedCalls; /* calls answered from a cache, which are not in the other totals */
+    double vars; /* the sum over all calls */
+    double constrs;
+    double seconds[NUM_SOLVER_PHASES];
+    struct solverCall last;
+};
+
+/*
+ * This function starts call, a call of the given kind over an m*n board, with no time spent yet.
+ */
+void startSolverCall(struct solverCall *call, enum solverKind kind, int m, int n);
+
+/*
+ * This function adds the time passed since since (on the monotonic clock of util/budget.h)
+ * to the given phase of call.
+ */
+void endSolverPhase(struct solverCall *call, enum solverPhase phase, double since);
+
+/*
+ * This function records call, which returned result, and writes it to the log if there is one.
+ */
+void recordSolverCall(struct solverCall *call, int result);
+
+/*
+ * This function records a call to the solver of the given kind which was answered from its cache.
+ */
+void recordCachedSolverCall(enum solverKind kind);
+
+/*
+ * This method returns the totals of the solver of the given kind.
+ */
+struct solverTotals *solverStatistics(enum solverKind kind);
+
+/*
+ * This method returns the name of the solver of the given kind.
+ */
+char *solverKindName(enum solverKind kind);
+
+/*
+ * This function starts writing every call to the file at path, as a line of comma separated values,
+ * after a header line. Any previous log is closed. If path == NULL, the log is only closed.
+ * It returns -1 if the file could not be opened, and 0 otherwise.
+ */
+int setSolverLog(char *path);
+
+/*
+ * This method returns the file every call is written to, or NULL if there is no log.
+ */
+char *solverLogPath();
+
+/*
+ * This function sets the file every Gurobi model is written to before it is optimized,
+ * in a format the extension of path tells (e.g. ".lp" or ".mps").
+ * If path == NULL, the models are not written.
+ * It returns -1 if path is too long, and 0 otherwise.
+ */
+int setModelExport(char *path);
+
+/*
+ * This method returns the file every Gurobi model is written to before it is optimized,
+ * or NULL if the models are not written.
+ */
+char *modelExportPath();
+
+/*
+ * This function closes the log, and stops exporting the models.
+ */
+void releaseSolverStatistics();
+
+#endif